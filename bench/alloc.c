@@ -0,0 +1,92 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Small allocations from several threads: each thread frees and allocates
+   again one of 64 blocks of 8 to 256 bytes, 2M times, with libc malloc()
+   then with SCE_malloc(). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+#include "bench.h"
+
+#define N_OPS 2000000
+#define N_BLOCKS 64
+#define MAX_THREADS 16
+
+static int use_sce = SCE_FALSE;
+
+static void* run (void *arg)
+{
+    unsigned int seed = (unsigned long)arg, i;
+    void *blocks[N_BLOCKS] = {NULL};
+
+    for (i = 0; i < N_OPS; i++) {
+        unsigned int k = i % N_BLOCKS;
+        size_t size = 8 + rand_r (&seed) % 249;
+        if (use_sce) {
+            SCE_free (blocks[k]);
+            blocks[k] = SCE_malloc (size);
+        } else {
+            free (blocks[k]);
+            blocks[k] = malloc (size);
+        }
+        *(char*)blocks[k] = 1;
+    }
+    for (i = 0; i < N_BLOCKS; i++) {
+        if (use_sce)
+            SCE_free (blocks[i]);
+        else
+            free (blocks[i]);
+    }
+    return NULL;
+}
+
+static double bench (int n_threads)
+{
+    pthread_t threads[MAX_THREADS];
+    double t = SCE_Bench_Now ();
+    long i;
+
+    for (i = 0; i < n_threads; i++)
+        pthread_create (&threads[i], NULL, run, (void*)(i + 1));
+    for (i = 0; i < n_threads; i++)
+        pthread_join (threads[i], NULL);
+    return SCE_Bench_Now () - t;
+}
+
+int main (void)
+{
+    int n;
+
+    SCE_Init_Utils (stderr);
+    for (n = 1; n <= MAX_THREADS; n *= 2) {
+        double libc, sce;
+        use_sce = SCE_FALSE;
+        libc = bench (n);
+        use_sce = SCE_TRUE;
+        sce = bench (n);
+        printf ("%2d threads: libc %.3fs  SCE_malloc %.3fs\n", n, libc, sce);
+    }
+    SCE_Quit_Utils ();
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Stress test of SCE_malloc(), SCE_realloc() and SCE_free() from several
+   threads, mixing small and large blocks and checking their contents.
+   Usage: alloc_stress [threads], 8 threads by default. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+
+#define N_OPS 200000
+#define N_BLOCKS 4096
+#define MAX_THREADS 16
+
+static int failed = SCE_FALSE;
+
+static void* run (void *arg)
+{
+    unsigned int seed = (unsigned long)arg, i;
+    unsigned char fill = (unsigned long)arg;
+    void **blocks = calloc (N_BLOCKS, sizeof *blocks);
+    size_t *sizes = calloc (N_BLOCKS, sizeof *sizes);
+
+    for (i = 0; i < N_OPS; i++) {
+        unsigned int k = rand_r (&seed) % N_BLOCKS;
+        size_t size = rand_r (&seed) % 300;
+        if (rand_r (&seed) % 50 == 0)
+            size += 5000;
+        if (blocks[k]) {
+            size_t j, n = sizes[k] < size ? sizes[k] : size;
+            for (j = 0; j < sizes[k]; j++) {
+                if (((unsigned char*)blocks[k])[j] != fill) {
+                    failed = SCE_TRUE;
+                    break;
+                }
+            }
+            if (rand_r (&seed) % 4 == 0) {
+                blocks[k] = SCE_realloc (blocks[k], size);
+                for (j = 0; j < n; j++) {
+                    if (((unsigned char*)blocks[k])[j] != fill)
+                        failed = SCE_TRUE;
+                }
+                memset (blocks[k], fill, size);
+                sizes[k] = size;
+            } else {
+                SCE_free (blocks[k]);
+                blocks[k] = NULL;
+            }
+        } else {
+            blocks[k] = SCE_malloc (size);
+            memset (blocks[k], fill, size);
+            sizes[k] = size;
+        }
+    }
+    for (i = 0; i < N_BLOCKS; i++)
+        SCE_free (blocks[i]);
+    free (blocks);
+    free (sizes);
+    return NULL;
+}
+
+int main (int argc, char **argv)
+{
+    pthread_t threads[MAX_THREADS];
+    long i, n = argc > 1 ? atoi (argv[1]) : 8;
+
+    if (n < 1 || n > MAX_THREADS)
+        n = 8;
+    SCE_Init_Utils (stderr);
+    for (i = 0; i < n; i++)
+        pthread_create (&threads[i], NULL, run, (void*)(i + 1));
+    for (i = 0; i < n; i++)
+        pthread_join (threads[i], NULL);
+#ifdef SCE_DEBUG
+    SCE_Mem_List ();
+#endif
+    SCE_Quit_Utils ();
+    printf ("%ld threads: %s\n", n, failed ? "corrupted blocks" : "ok");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Sorts a list of random, sorted and reversed keys with
+   SCE_List_MergeSort(), SCE_List_GnomeSort() and SCE_List_QuickSort(), and
+   checks that the result is sorted and that the merge sort is stable.
+   Usage: listsort [n], 3000 elements by default. The gnome and quick sorts
+   are quadratic and skipped above 5000 elements. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCE/utils/SCEUtils.h>
+#include "bench.h"
+
+#define MAX_QUADRATIC 5000
+
+typedef struct {
+    int key;
+    int order;                  /* position before sorting */
+} Item;
+
+typedef void (*SortFunc)(SCE_SList*, SCE_FListCompareData);
+
+static int compare (const void *a, const void *b)
+{
+    return ((const Item*)a)->key - ((const Item*)b)->key;
+}
+
+/* returns the time taken, or a negative value if the result is wrong */
+static double bench (SortFunc sort, Item *items, int n, int stable)
+{
+    SCE_SList l;
+    SCE_SListIterator *it = NULL;
+    Item *prev = NULL;
+    int i, ok = SCE_TRUE;
+    double t;
+
+    SCE_List_Init (&l);
+    SCE_List_CanDeleteIterators (&l, SCE_TRUE);
+    for (i = 0; i < n; i++)
+        SCE_List_AppendNewl (&l, &items[i]);
+    t = SCE_Bench_Now ();
+    sort (&l, compare);
+    t = SCE_Bench_Now () - t;
+    i = 0;
+    SCE_List_ForEach (it, &l) {
+        Item *item = SCE_List_GetData (it);
+        if (prev && (prev->key > item->key || (stable &&
+                     prev->key == item->key && prev->order > item->order)))
+            ok = SCE_FALSE;
+        if (it->prev->next != it)
+            ok = SCE_FALSE;
+        prev = item;
+        i++;
+    }
+    if (i != n)
+        ok = SCE_FALSE;
+    SCE_List_Clear (&l);
+    return ok ? t : -1.0;
+}
+
+int main (int argc, char **argv)
+{
+    const char *names[] = {"random", "sorted", "reversed"};
+    int i, k, n = argc > 1 ? atoi (argv[1]) : 3000;
+    Item *items = NULL;
+
+    if (n < 1)
+        n = 3000;
+    SCE_Init_Utils (stderr);
+    items = malloc (n * sizeof *items);
+    srand (1);
+    for (k = 0; k < 3; k++) {
+        double merge, gnome = 0.0, quick = 0.0;
+        for (i = 0; i < n; i++) {
+            items[i].order = i;
+            if (k == 0)
+                items[i].key = rand () % (n / 4 + 1);  /* many equal keys */
+            else
+                items[i].key = k == 1 ? i : n - i;
+        }
+        merge = bench (SCE_List_MergeSort, items, n, SCE_TRUE);
+        if (n <= MAX_QUADRATIC) {
+            gnome = bench (SCE_List_GnomeSort, items, n, SCE_FALSE);
+            quick = bench (SCE_List_QuickSort, items, n, SCE_FALSE);
+        }
+        if (merge < 0.0 || gnome < 0.0 || quick < 0.0) {
+            printf ("%s: wrong result\n", names[k]);
+            return EXIT_FAILURE;
+        }
+        printf ("%-8s n=%d  merge %.4fs", names[k], n, merge);
+        if (n <= MAX_QUADRATIC)
+            printf ("  gnome %.4fs  quick %.4fs", gnome, quick);
+        printf ("\n");
+    }
+    free (items);
+    SCE_Quit_Utils ();
+    return 0;
+}
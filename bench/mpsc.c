@@ -0,0 +1,153 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* 4 producers push 1M items each to one consumer, through an
+   SCE_SMPSCQueue drained into an SCE_SList, then through an SCE_SList
+   protected by a mutex. Checks that every item arrives once and in the
+   order of its producer, and prints the throughput. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+#include <SCE/utils/SCEQueue.h>
+#include "bench.h"
+
+#define N_PRODUCERS 4
+#define N_ITEMS 1000000         /* per producer */
+
+typedef struct {
+    SCE_SListIterator it;
+    unsigned int producer;
+    unsigned int seq;
+} Item;
+
+static Item *items[N_PRODUCERS];
+static SCE_SMPSCQueue queue;
+static SCE_SList locked_list;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static int use_queue = SCE_TRUE;
+
+static void* produce (void *arg)
+{
+    Item *mine = arg;
+    unsigned int i;
+
+    for (i = 0; i < N_ITEMS; i++) {
+        if (use_queue)
+            SCE_MPSCQueue_Push (&queue, &mine[i].it);
+        else {
+            pthread_mutex_lock (&mutex);
+            SCE_List_Appendl (&locked_list, &mine[i].it);
+            pthread_mutex_unlock (&mutex);
+        }
+    }
+    return NULL;
+}
+
+/* consumes everything, returns SCE_ERROR if an item is lost, duplicated
+   or out of order */
+static int consume (void)
+{
+    unsigned int next[N_PRODUCERS] = {0};
+    unsigned long received = 0;
+    SCE_SListIterator *it = NULL;
+    SCE_SList l;
+    int ok = SCE_TRUE;
+
+    SCE_List_Init (&l);
+    while (received < (unsigned long)N_PRODUCERS * N_ITEMS) {
+        if (use_queue)
+            SCE_MPSCQueue_Drain (&queue, &l);
+        else {
+            pthread_mutex_lock (&mutex);
+            SCE_List_AppendAll (&l, &locked_list);
+            pthread_mutex_unlock (&mutex);
+        }
+        if (!SCE_List_HasElements (&l)) {
+            sched_yield ();
+            continue;
+        }
+        SCE_List_ForEach (it, &l) {
+            Item *item = SCE_List_GetData (it);
+            if (item->seq != next[item->producer]++)
+                ok = SCE_FALSE;
+            received++;
+        }
+        SCE_List_Flush (&l);
+    }
+    if (use_queue && !SCE_MPSCQueue_IsEmpty (&queue))
+        ok = SCE_FALSE;
+    return ok ? SCE_OK : SCE_ERROR;
+}
+
+static int bench (int queued)
+{
+    pthread_t producers[N_PRODUCERS];
+    unsigned int i;
+    double t;
+    int ok;
+
+    use_queue = queued;
+    SCE_MPSCQueue_Init (&queue);
+    SCE_List_Init (&locked_list);
+    for (i = 0; i < N_PRODUCERS; i++) {
+        unsigned int j;
+        for (j = 0; j < N_ITEMS; j++) {
+            SCE_List_InitIt (&items[i][j].it);
+            SCE_List_SetData (&items[i][j].it, &items[i][j]);
+        }
+    }
+    t = SCE_Bench_Now ();
+    for (i = 0; i < N_PRODUCERS; i++)
+        pthread_create (&producers[i], NULL, produce, items[i]);
+    ok = consume ();
+    for (i = 0; i < N_PRODUCERS; i++)
+        pthread_join (producers[i], NULL);
+    t = SCE_Bench_Now () - t;
+    printf ("%-18s %5.1f Mitems/s  %s\n",
+            queued ? "MPSC queue" : "mutex + SCE_SList",
+            N_PRODUCERS * N_ITEMS / t / 1e6,
+            ok == SCE_OK ? "ok" : "lost, duplicated or reordered items");
+    return ok;
+}
+
+int main (void)
+{
+    unsigned int i, j;
+    int ok;
+
+    SCE_Init_Utils (stderr);
+    for (i = 0; i < N_PRODUCERS; i++) {
+        if (!(items[i] = malloc (N_ITEMS * sizeof *items[i])))
+            return EXIT_FAILURE;
+        for (j = 0; j < N_ITEMS; j++) {
+            items[i][j].producer = i;
+            items[i][j].seq = j;
+        }
+    }
+    ok = bench (SCE_TRUE) == SCE_OK && bench (SCE_FALSE) == SCE_OK;
+    for (i = 0; i < N_PRODUCERS; i++)
+        free (items[i]);
+    SCE_Quit_Utils ();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
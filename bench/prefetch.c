@@ -0,0 +1,150 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Updates particles through a list whose iterators and data are shuffled
+   across two large pools, with SCE_List_FastForEach2(),
+   SCE_List_PrefetchForEach2() at several distances and
+   SCE_List_BatchForEach(). Runs once with a callback doing about 40
+   flops per particle and once with a trivial one. Prints nanoseconds per
+   element. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCE/utils/SCEUtils.h>
+#include "bench.h"
+
+/* 64 bytes */
+typedef struct {
+    float x, y, z;
+    float vx, vy, vz;
+    char pad[40];
+} Particle;
+
+/* iterations of the inner loop of the callbacks, 2 flops each */
+static int work = 0;
+
+static void update (void *data, void *param)
+{
+    Particle *p = data;
+    int k;
+    (void)param;
+    for (k = 0; k < work; k++)
+        p->vy = p->vy * 0.999f + p->vz;
+    p->x += p->vx * 0.01f;
+    p->y += p->vy * 0.01f;
+    p->z += p->vz * 0.01f;
+}
+static void update_batch (void **data, unsigned int n, void *param)
+{
+    unsigned int i;
+    for (i = 0; i < n; i++)
+        update (data[i], param);
+}
+
+static size_t random_index (size_t n)
+{
+    return (((size_t)rand () << 16) ^ rand ()) % n;
+}
+static void shuffle (size_t *a, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        a[i] = i;
+    for (i = n - 1; i > 0; i--) {
+        size_t j = random_index (i + 1), t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+}
+
+static int bench (size_t n)
+{
+    const unsigned int distances[] = {4, 8, 16, 32};
+    SCE_SListIterator *its = malloc (n * sizeof *its);
+    Particle *particles = calloc (n, sizeof *particles);
+    size_t *order_its = malloc (n * sizeof *order_its);
+    size_t *order_data = malloc (n * sizeof *order_data);
+    int r, reps = n >= 1000000 ? 3 : 20;
+    unsigned int d;
+    SCE_SList l;
+    size_t i;
+    double t;
+
+    if (!its || !particles || !order_its || !order_data)
+        return SCE_ERROR;
+    shuffle (order_its, n);
+    shuffle (order_data, n);
+    SCE_List_Init (&l);
+    for (i = 0; i < n; i++) {
+        SCE_SListIterator *it = &its[order_its[i]];
+        SCE_List_InitIt (it);
+        SCE_List_SetData (it, &particles[order_data[i]]);
+        particles[order_data[i]].vx = 1.0f;
+        SCE_List_Appendl (&l, it);
+    }
+
+    SCE_List_FastForEach2 (&l, n, update, NULL); /* warm up */
+    t = SCE_Bench_Now ();
+    for (r = 0; r < reps; r++)
+        SCE_List_FastForEach2 (&l, n, update, NULL);
+    printf ("n=%-8lu fast %6.1f", (unsigned long)n,
+            (SCE_Bench_Now () - t) / reps * 1e9 / n);
+    for (d = 0; d < sizeof distances / sizeof *distances; d++) {
+        t = SCE_Bench_Now ();
+        for (r = 0; r < reps; r++)
+            SCE_List_PrefetchForEach2 (&l, distances[d], update, NULL);
+        printf ("  pf%-2u %6.1f", distances[d],
+                (SCE_Bench_Now () - t) / reps * 1e9 / n);
+    }
+    t = SCE_Bench_Now ();
+    for (r = 0; r < reps; r++)
+        SCE_List_BatchForEach (&l, 32, 16, update_batch, NULL);
+    printf ("  batch32/pf16 %6.1f ns/elem\n",
+            (SCE_Bench_Now () - t) / reps * 1e9 / n);
+
+    free (its);
+    free (particles);
+    free (order_its);
+    free (order_data);
+    return SCE_OK;
+}
+
+int main (void)
+{
+    const int works[] = {20, 0};
+    const size_t sizes[] = {100000, 1000000, 4000000};
+    size_t i, j;
+
+    SCE_Init_Utils (stderr);
+    srand (1);
+    for (j = 0; j < sizeof works / sizeof *works; j++) {
+        work = works[j];
+        printf ("%s callback:\n", work ? "40 flops" : "trivial");
+        for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+            if (bench (sizes[i]) < 0) {
+                printf ("n=%lu: out of memory\n", (unsigned long)sizes[i]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    SCE_Quit_Utils ();
+    return 0;
+}
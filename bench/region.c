@@ -0,0 +1,86 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Appends 400MB to an SCE_SArray in pieces of 4KB, first growing it with
+   realloc(), then in a region reserved by SCE_Array_SetMaxSize(). Prints
+   the time, the number of times the data moved and the minor page faults.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <SCE/utils/SCEUtils.h>
+#include "bench.h"
+
+#define TOTAL_SIZE ((size_t)400 << 20)
+#define PIECE_SIZE 4096
+
+static long get_minor_faults (void)
+{
+    struct rusage u;
+    getrusage (RUSAGE_SELF, &u);
+    return u.ru_minflt;
+}
+
+static int bench (int region)
+{
+    SCE_SArray a;
+    char piece[PIECE_SIZE];
+    void *data = NULL;
+    size_t i;
+    long faults;
+    int moves = 0;
+    double t;
+
+    memset (piece, 1, sizeof piece);
+    SCE_Array_Init (&a);
+    if (region && SCE_Array_SetMaxSize (&a, (size_t)1 << 31) < 0)
+        return SCE_ERROR;
+    faults = get_minor_faults ();
+    t = SCE_Bench_Now ();
+    for (i = 0; i < TOTAL_SIZE / PIECE_SIZE; i++) {
+        if (SCE_Array_Append (&a, piece, sizeof piece) < 0)
+            return SCE_ERROR;
+        if (SCE_Array_Get (&a) != data) {
+            data = SCE_Array_Get (&a);
+            moves++;
+        }
+    }
+    t = SCE_Bench_Now () - t;
+    faults = get_minor_faults () - faults;
+    /* the first allocation is not a move */
+    printf ("%-8s %.3fs, %3d moves, %6ld minor page faults\n",
+            region ? "region" : "realloc", t, moves - 1, faults);
+    SCE_Array_Clear (&a);
+    return SCE_OK;
+}
+
+int main (void)
+{
+    SCE_Init_Utils (stderr);
+    if (bench (SCE_FALSE) < 0 || bench (SCE_TRUE) < 0) {
+        SCEE_Out ();
+        return EXIT_FAILURE;
+    }
+    SCE_Quit_Utils ();
+    return 0;
+}
@@ -0,0 +1,323 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Moves items through the ring buffers of SCEQueue and through an
+   SCE_SList protected by a mutex:
+   - SPSC ring, one producer and one consumer, checks the order;
+   - MPMC ring, 4 producers and 4 consumers, checks that each item is
+     received exactly once;
+   - mutex + SCE_SList, one producer and one consumer;
+   - round trips between two threads, SPSC rings against a mutex and a
+     condition variable.
+   Usage: ring [capacity [items]], 1024 and 4M by default; small rings
+   like "ring 2 300000" stress the full and empty cases. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+#include <SCE/utils/SCEQueue.h>
+#include "bench.h"
+
+#define N_THREADS 4             /* producers and consumers of the MPMC ring */
+#define MAX_BATCH 32
+#define N_ROUND_TRIPS 100000
+
+static size_t n_items = 4000000;
+static size_t batch = 1;
+static int failed = SCE_FALSE;
+
+static SCE_SSPSCRing spsc;
+static SCE_SMPMCRing mpmc;
+static unsigned char *received = NULL;
+
+/* items are the integers from 1 to n_items, NULL cannot be pushed */
+static void* spsc_produce (void *arg)
+{
+    void *buf[MAX_BATCH];
+    size_t i = 1, k;
+    (void)arg;
+    while (i <= n_items) {
+        for (k = 0; k < batch && i + k <= n_items; k++)
+            buf[k] = (void*)(i + k);
+        SCE_SPSCRing_PushN (&spsc, buf, k, SCE_TRUE);
+        i += k;
+    }
+    SCE_SPSCRing_Close (&spsc);
+    return NULL;
+}
+static void* spsc_consume (void *arg)
+{
+    void *buf[MAX_BATCH];
+    size_t expected = 1, k, j;
+    (void)arg;
+    while ((k = SCE_SPSCRing_PopN (&spsc, buf, batch, SCE_TRUE))) {
+        for (j = 0; j < k; j++) {
+            if ((size_t)buf[j] != expected++)
+                failed = SCE_TRUE;
+        }
+    }
+    if (expected != n_items + 1)
+        failed = SCE_TRUE;
+    return NULL;
+}
+
+/* producer i pushes the items i + 1, i + 1 + N_THREADS... */
+static void* mpmc_produce (void *arg)
+{
+    void *buf[MAX_BATCH];
+    size_t i = (size_t)arg, k;
+    while (i < n_items) {
+        for (k = 0; k < batch && i < n_items; k++, i += N_THREADS)
+            buf[k] = (void*)(i + 1);
+        SCE_MPMCRing_PushN (&mpmc, buf, k, SCE_TRUE);
+    }
+    return NULL;
+}
+static void* mpmc_consume (void *arg)
+{
+    void *buf[MAX_BATCH];
+    size_t k, j;
+    (void)arg;
+    while ((k = SCE_MPMCRing_PopN (&mpmc, buf, batch, SCE_TRUE))) {
+        for (j = 0; j < k; j++) {
+            size_t v = (size_t)buf[j] - 1;
+            if (__atomic_exchange_n (&received[v], 1, __ATOMIC_RELAXED))
+                failed = SCE_TRUE;
+        }
+    }
+    return NULL;
+}
+
+static double bench_spsc (size_t capacity)
+{
+    pthread_t threads[2];
+    double t;
+
+    SCE_SPSCRing_Init (&spsc, capacity);
+    t = SCE_Bench_Now ();
+    pthread_create (&threads[0], NULL, spsc_produce, NULL);
+    pthread_create (&threads[1], NULL, spsc_consume, NULL);
+    pthread_join (threads[0], NULL);
+    pthread_join (threads[1], NULL);
+    t = SCE_Bench_Now () - t;
+    SCE_SPSCRing_Clear (&spsc);
+    return t;
+}
+static double bench_mpmc (size_t capacity)
+{
+    pthread_t threads[2 * N_THREADS];
+    size_t i;
+    double t;
+
+    SCE_MPMCRing_Init (&mpmc, capacity);
+    received = calloc (n_items, 1);
+    t = SCE_Bench_Now ();
+    for (i = 0; i < N_THREADS; i++) {
+        pthread_create (&threads[i], NULL, mpmc_produce, (void*)i);
+        pthread_create (&threads[N_THREADS + i], NULL, mpmc_consume, NULL);
+    }
+    for (i = 0; i < N_THREADS; i++)
+        pthread_join (threads[i], NULL);
+    /* wakes up the consumers once the ring is empty */
+    SCE_MPMCRing_Close (&mpmc);
+    for (i = 0; i < N_THREADS; i++)
+        pthread_join (threads[N_THREADS + i], NULL);
+    t = SCE_Bench_Now () - t;
+    for (i = 0; i < n_items; i++) {
+        if (!received[i])
+            failed = SCE_TRUE;
+    }
+    free (received);
+    SCE_MPMCRing_Clear (&mpmc);
+    return t;
+}
+
+static SCE_SList locked_list;
+static SCE_SListIterator *its = NULL;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int done = SCE_FALSE;
+
+static void* list_produce (void *arg)
+{
+    size_t i;
+    (void)arg;
+    for (i = 0; i < n_items; i++) {
+        pthread_mutex_lock (&mutex);
+        SCE_List_Appendl (&locked_list, &its[i]);
+        pthread_cond_signal (&cond);
+        pthread_mutex_unlock (&mutex);
+    }
+    pthread_mutex_lock (&mutex);
+    done = SCE_TRUE;
+    pthread_cond_broadcast (&cond);
+    pthread_mutex_unlock (&mutex);
+    return NULL;
+}
+static void* list_consume (void *arg)
+{
+    SCE_SListIterator *it = NULL;
+    size_t expected = 0;
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock (&mutex);
+        while (!SCE_List_HasElements (&locked_list) && !done)
+            pthread_cond_wait (&cond, &mutex);
+        it = NULL;
+        if (SCE_List_HasElements (&locked_list))
+            it = SCE_List_RemoveFirst (&locked_list);
+        pthread_mutex_unlock (&mutex);
+        if (!it)
+            break;
+        if ((size_t)SCE_List_GetData (it) != expected++)
+            failed = SCE_TRUE;
+    }
+    if (expected != n_items)
+        failed = SCE_TRUE;
+    return NULL;
+}
+static double bench_list (void)
+{
+    pthread_t threads[2];
+    double t;
+
+    SCE_List_Init (&locked_list);
+    done = SCE_FALSE;
+    t = SCE_Bench_Now ();
+    pthread_create (&threads[0], NULL, list_produce, NULL);
+    pthread_create (&threads[1], NULL, list_consume, NULL);
+    pthread_join (threads[0], NULL);
+    pthread_join (threads[1], NULL);
+    return SCE_Bench_Now () - t;
+}
+
+/* round trips: the echo thread sends back what it receives */
+static SCE_SSPSCRing ping, pong;
+static int echoed = SCE_FALSE;
+
+static void* echo_ring (void *arg)
+{
+    void *x = NULL;
+    int i;
+    (void)arg;
+    for (i = 0; i < N_ROUND_TRIPS; i++) {
+        SCE_SPSCRing_PopN (&ping, &x, 1, SCE_TRUE);
+        SCE_SPSCRing_PushN (&pong, &x, 1, SCE_TRUE);
+    }
+    return NULL;
+}
+static void* echo_list (void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < N_ROUND_TRIPS; i++) {
+        pthread_mutex_lock (&mutex);
+        while (!SCE_List_HasElements (&locked_list))
+            pthread_cond_wait (&cond, &mutex);
+        SCE_List_RemoveFirst (&locked_list);
+        echoed = SCE_TRUE;
+        pthread_cond_broadcast (&cond);
+        pthread_mutex_unlock (&mutex);
+    }
+    return NULL;
+}
+static void bench_round_trips (void)
+{
+    pthread_t thread;
+    void *x = &ping;
+    double t;
+    int i;
+
+    SCE_SPSCRing_Init (&ping, 64);
+    SCE_SPSCRing_Init (&pong, 64);
+    pthread_create (&thread, NULL, echo_ring, NULL);
+    t = SCE_Bench_Now ();
+    for (i = 0; i < N_ROUND_TRIPS; i++) {
+        SCE_SPSCRing_PushN (&ping, &x, 1, SCE_TRUE);
+        SCE_SPSCRing_PopN (&pong, &x, 1, SCE_TRUE);
+    }
+    pthread_join (thread, NULL);
+    t = SCE_Bench_Now () - t;
+    printf ("round trip, SPSC rings        %6.2f us\n",
+            t / N_ROUND_TRIPS * 1e6);
+    SCE_SPSCRing_Clear (&ping);
+    SCE_SPSCRing_Clear (&pong);
+
+    SCE_List_Init (&locked_list);
+    pthread_create (&thread, NULL, echo_list, NULL);
+    t = SCE_Bench_Now ();
+    for (i = 0; i < N_ROUND_TRIPS; i++) {
+        pthread_mutex_lock (&mutex);
+        echoed = SCE_FALSE;
+        SCE_List_Appendl (&locked_list, &its[i]);
+        pthread_cond_broadcast (&cond);
+        while (!echoed)
+            pthread_cond_wait (&cond, &mutex);
+        pthread_mutex_unlock (&mutex);
+    }
+    pthread_join (thread, NULL);
+    t = SCE_Bench_Now () - t;
+    printf ("round trip, mutex + SCE_SList %6.2f us\n",
+            t / N_ROUND_TRIPS * 1e6);
+}
+
+int main (int argc, char **argv)
+{
+    size_t batches[] = {1, MAX_BATCH};
+    size_t i, capacity = argc > 1 ? strtoul (argv[1], NULL, 10) : 1024;
+
+    if (argc > 2)
+        n_items = strtoul (argv[2], NULL, 10);
+    if (!capacity || n_items < N_ROUND_TRIPS) {
+        fprintf (stderr, "usage: %s [capacity [items]], at least %d "
+                 "items\n", argv[0], N_ROUND_TRIPS);
+        return EXIT_FAILURE;
+    }
+    SCE_Init_Utils (stderr);
+    for (i = 0; i < 2; i++) {
+        double t;
+        batch = batches[i];
+        t = bench_spsc (capacity);
+        printf ("SPSC 1P1C, batches of %2lu      %6.1f Mitems/s\n",
+                (unsigned long)batch, n_items / t / 1e6);
+        t = bench_mpmc (capacity);
+        printf ("MPMC %dP%dC, batches of %2lu      %6.1f Mitems/s\n",
+                N_THREADS, N_THREADS, (unsigned long)batch,
+                n_items / t / 1e6);
+    }
+    its = malloc (n_items * sizeof *its);
+    for (i = 0; i < n_items; i++) {
+        SCE_List_InitIt (&its[i]);
+        SCE_List_SetData (&its[i], (void*)i);
+    }
+    printf ("mutex + SCE_SList 1P1C        %6.1f Mitems/s\n",
+            n_items / bench_list () / 1e6);
+    bench_round_trips ();
+    free (its);
+    SCE_Quit_Utils ();
+    if (failed) {
+        printf ("lost, duplicated or reordered items\n");
+        return EXIT_FAILURE;
+    }
+    printf ("ok\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+/* Sums an int through each element of an SCE_SList and of an SCE_SVector
+   holding the same pointers. The iterators are allocated between other
+   blocks, as they would be in a live heap. Prints nanoseconds per
+   element. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCE/utils/SCEUtils.h>
+#include "bench.h"
+
+/* elements visited per measurement */
+#define N_VISITS 100000000
+
+static int bench (size_t n)
+{
+    SCE_SList l;
+    SCE_SVector v;
+    SCE_SListIterator *it = NULL;
+    void **vit = NULL;
+    int *data = NULL;
+    void **noise = NULL;
+    long sum_list = 0, sum_vector = 0;
+    size_t i, r, reps = N_VISITS / n;
+    double t_list, t_vector;
+
+    data = malloc (n * sizeof *data);
+    noise = malloc (n * sizeof *noise);
+    SCE_List_Init (&l);
+    SCE_List_CanDeleteIterators (&l, SCE_TRUE);
+    SCE_Vector_Init (&v);
+    if (!data || !noise || SCE_Vector_Reserve (&v, n) < 0)
+        return SCE_ERROR;
+    for (i = 0; i < n; i++) {
+        data[i] = i;
+        if (SCE_List_AppendNewl (&l, &data[i]) < 0)
+            return SCE_ERROR;
+        SCE_Vector_Push (&v, &data[i]);
+        noise[i] = i % 3 ? NULL : SCE_malloc (48);
+    }
+
+    t_list = SCE_Bench_Now ();
+    for (r = 0; r < reps; r++) {
+        SCE_List_ForEach (it, &l)
+            sum_list += *(int*)SCE_List_GetData (it);
+    }
+    t_list = SCE_Bench_Now () - t_list;
+    t_vector = SCE_Bench_Now ();
+    for (r = 0; r < reps; r++) {
+        SCE_Vector_ForEach (vit, &v)
+            sum_vector += *(int*)*vit;
+    }
+    t_vector = SCE_Bench_Now () - t_vector;
+    if (sum_list != sum_vector)
+        return SCE_ERROR;
+    printf ("n=%-8lu list %6.2f ns/elem  vector %5.2f ns/elem\n",
+            (unsigned long)n, t_list * 1e9 / (reps * n),
+            t_vector * 1e9 / (reps * n));
+
+    for (i = 0; i < n; i++)
+        SCE_free (noise[i]);
+    free (noise);
+    SCE_List_Clear (&l);
+    SCE_Vector_Clear (&v);
+    free (data);
+    return SCE_OK;
+}
+
+int main (void)
+{
+    size_t sizes[] = {1000, 100000, 1000000};
+    size_t i;
+
+    SCE_Init_Utils (stderr);
+    for (i = 0; i < sizeof sizes / sizeof *sizes; i++) {
+        if (bench (sizes[i]) < 0) {
+            printf ("n=%lu: failed\n", (unsigned long)sizes[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    SCE_Quit_Utils ();
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEARENA_H
+#define SCEARENA_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup arena
+ * @{
+ */
+
+/** \brief Default size of the chunks of an arena */
+#define SCE_ARENA_CHUNK_SIZE 65536
+/** \brief Alignment of the blocks returned by SCE_Arena_Alloc() */
+#define SCE_ARENA_ALIGN 16
+
+typedef struct sce_sarenachunk SCE_SArenaChunk;
+/**
+ * \brief A chunk of an arena, its data follows the structure
+ */
+struct sce_sarenachunk {
+    SCE_SArenaChunk *next;
+    size_t size;                /**< Size of the data of the chunk */
+    size_t used;                /**< Bytes used in the data of the chunk */
+};
+
+typedef struct sce_sarena SCE_SArena;
+/**
+ * \brief A linear allocator
+ */
+struct sce_sarena {
+    SCE_SArenaChunk *first;     /**< First chunk */
+    SCE_SArenaChunk *current;   /**< Chunk being filled */
+    size_t chunk_size;          /**< Minimum size of the new chunks */
+    unsigned int n_resets;      /**< Number of calls to SCE_Arena_Reset() */
+    SCE_SListIterator it;       /**< Used to track the arenas in debug mode */
+};
+
+typedef struct sce_sarenamark SCE_SArenaMark;
+/**
+ * \brief Position in an arena, see SCE_Arena_GetMark()
+ */
+struct sce_sarenamark {
+    SCE_SArenaChunk *chunk;
+    size_t used;
+};
+
+/** @} */
+
+int SCE_Init_Arena (void);
+void SCE_Quit_Arena (void);
+
+void SCE_Arena_Init (SCE_SArena*);
+void SCE_Arena_Clear (SCE_SArena*);
+SCE_SArena* SCE_Arena_Create (void);
+void SCE_Arena_Delete (SCE_SArena*);
+
+void SCE_Arena_SetChunkSize (SCE_SArena*, size_t);
+
+void* SCE_Arena_Alloc (SCE_SArena*, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (2);
+void* SCE_Arena_AllocAligned (SCE_SArena*, size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (3);
+void* SCE_Arena_Dup (SCE_SArena*, const void*, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (3);
+
+void SCE_Arena_GetMark (const SCE_SArena*, SCE_SArenaMark*);
+void SCE_Arena_PopMark (SCE_SArena*, const SCE_SArenaMark*);
+void SCE_Arena_Reset (SCE_SArena*);
+
+size_t SCE_Arena_GetUsed (const SCE_SArena*);
+
+SCE_SArena* SCE_Arena_GetThreadArena (void);
+
+#ifdef SCE_DEBUG
+void SCE_Arena_List (void);
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
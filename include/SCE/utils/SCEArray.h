@@ -17,28 +17,94 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/05/2012
-   updated: 17/05/2012 */
+   updated: 18/10/2026 */
 
 #ifndef SCEARRAY_H
 #define SCEARRAY_H
 
+#include "SCE/utils/SCEMemory.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** \brief Minimum size bound from which arrays are stored in a region,
+ * see SCE_Array_SetMaxSize() */
+#define SCE_ARRAY_REGION_SIZE (1024 * 1024)
+/** \brief Smallest allocation of an array, in bytes */
+#define SCE_ARRAY_MIN_SIZE 64
+/** \brief Default growth factor of arrays, see SCE_Array_SetGrowth() */
+#define SCE_ARRAY_DEFAULT_GROWTH 2.0f
+
 typedef struct sce_sarray SCE_SArray;
 struct sce_sarray {
     unsigned char *ptr;
     size_t size;
     size_t allocated;
+    size_t align;               /* alignment of ptr, 0 for the default */
+    unsigned int growth;        /* factor applied to allocated when full,
+                                 * in 1/256th */
+    unsigned char *inline_ptr;  /* storage used before the first
+                                 * allocation, see SCE_Array_InitInline() */
+    size_t inline_size;
+    SCE_SMemRegion region;      /* storage of big arrays */
 };
 
 void SCE_Array_Init (SCE_SArray*);
+void SCE_Array_InitInline (SCE_SArray*, void*, size_t);
 void SCE_Array_Clear (SCE_SArray*);
 
+void SCE_Array_SetAlignment (SCE_SArray*, size_t);
+int SCE_Array_SetMaxSize (SCE_SArray*, size_t);
+void SCE_Array_SetGrowth (SCE_SArray*, float);
+
+int SCE_Array_Reserve (SCE_SArray*, size_t);
+void* SCE_Array_Emplace (SCE_SArray*, size_t);
 int SCE_Array_Append (SCE_SArray*, void*, size_t);
+int SCE_Array_Pop (SCE_SArray*, void*, size_t);
+int SCE_Array_Resize (SCE_SArray*, size_t);
+void SCE_Array_Truncate (SCE_SArray*, size_t);
+int SCE_Array_ShrinkToFit (SCE_SArray*);
+int SCE_Array_IsInline (const SCE_SArray*);
 void* SCE_Array_Get (const SCE_SArray*);
 size_t SCE_Array_GetSize (const SCE_SArray*);
+size_t SCE_Array_GetCapacity (const SCE_SArray*);
+
+/**
+ * \brief Gets a pointer to the element \p i of an array of \p type
+ */
+#define SCE_Array_At(a, type, i) ((type*)SCE_Array_Get (a) + (i))
+/**
+ * \brief Gets the number of elements of an array of \p type
+ */
+#define SCE_Array_Count(a, type) (SCE_Array_GetSize (a) / sizeof (type))
+/**
+ * \brief Adds \p n uninitialized elements of \p type to an array
+ * \returns a pointer to the first new element, or NULL on error
+ * \sa SCE_Array_Emplace()
+ */
+#define SCE_Array_EmplaceN(a, type, n)\
+    ((type*)SCE_Array_Emplace ((a), (n) * sizeof (type)))
+
+/**
+ * \brief Declares a structure holding an array and \p n bytes of inline
+ * storage for it
+ *
+ * Initialize it with SCE_SmallArray_Init(), then use its \c array member
+ * with the regular SCE_Array_*() functions. The structure must not be
+ * copied nor moved while \c array uses the inline bytes.
+ * \sa SCE_Array_InitInline()
+ */
+#define SCE_SMALLARRAY(n)                       \
+    struct {                                    \
+        SCE_SArray array;                       \
+        unsigned char buf[n];                   \
+    }
+/**
+ * \brief Initializes a structure declared with SCE_SMALLARRAY()
+ */
+#define SCE_SmallArray_Init(s)\
+    SCE_Array_InitInline (&(s)->array, (s)->buf, sizeof (s)->buf)
 
 #ifdef __cplusplus
 } /* extern "C" */
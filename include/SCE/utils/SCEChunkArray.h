@@ -0,0 +1,103 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCECHUNKARRAY_H
+#define SCECHUNKARRAY_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup chunkarray
+ * @{
+ */
+
+/** \brief Default base 2 logarithm of the number of elements of a
+ * segment, see SCE_ChunkArray_Init() */
+#define SCE_CHUNKARRAY_DEFAULT_SHIFT 10
+/** \brief Largest accepted shift */
+#define SCE_CHUNKARRAY_MAX_SHIFT 24
+
+typedef struct sce_schunkarray SCE_SChunkArray;
+/**
+ * \brief An array made of fixed size segments, whose elements never move
+ */
+struct sce_schunkarray {
+    unsigned char **segments;   /**< Segments */
+    size_t n_segments;          /**< Number of allocated segments */
+    size_t max_segments;        /**< Size of \c segments */
+    size_t size;                /**< Number of elements */
+    size_t elem_size;           /**< Size of one element */
+    unsigned int shift;         /**< log2 of the elements per segment */
+    size_t mask;                /**< Elements per segment - 1 */
+};
+
+/**
+ * \brief Function called on consecutive elements of a chunked array
+ * \param elems the elements, stored next to each other
+ * \param first index of the first element of \p elems in the array
+ * \param n number of elements in \p elems
+ * \param param user data
+ */
+typedef void (*SCE_FChunkArrayFunc)(void *elems, size_t first, size_t n,
+                                    void *param);
+
+/** @} */
+
+void SCE_ChunkArray_Init (SCE_SChunkArray*, size_t, unsigned int);
+void SCE_ChunkArray_Clear (SCE_SChunkArray*);
+SCE_SChunkArray* SCE_ChunkArray_Create (size_t, unsigned int);
+void SCE_ChunkArray_Delete (SCE_SChunkArray*);
+
+int SCE_ChunkArray_Reserve (SCE_SChunkArray*, size_t);
+void SCE_ChunkArray_Flush (SCE_SChunkArray*);
+void* SCE_ChunkArray_Emplace (SCE_SChunkArray*);
+int SCE_ChunkArray_Push (SCE_SChunkArray*, const void*);
+int SCE_ChunkArray_Pop (SCE_SChunkArray*, void*);
+void SCE_ChunkArray_SwapRemove (SCE_SChunkArray*, size_t);
+size_t SCE_ChunkArray_GetSize (const SCE_SChunkArray*);
+
+size_t SCE_ChunkArray_GetNumSegments (const SCE_SChunkArray*);
+void* SCE_ChunkArray_GetSegment (const SCE_SChunkArray*, size_t, size_t*);
+void SCE_ChunkArray_ForEach (SCE_SChunkArray*, SCE_FChunkArrayFunc, void*);
+void SCE_ChunkArray_ParallelForEach (SCE_SChunkArray*, SCE_FChunkArrayFunc,
+                                     void*);
+
+/**
+ * \brief Gets a pointer to the element \p i of a chunked array
+ */
+#define SCE_ChunkArray_Get(a, i)                                        \
+    ((void*)((a)->segments[(i) >> (a)->shift] +                         \
+             ((i) & (a)->mask) * (a)->elem_size))
+/**
+ * \brief Gets a pointer to the element \p i of a chunked array of \p type
+ */
+#define SCE_ChunkArray_At(a, type, i) ((type*)SCE_ChunkArray_Get (a, i))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,139 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEDYNVECTOR_H
+#define SCEDYNVECTOR_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup dynvector
+ * @{
+ */
+
+typedef struct sce_svector SCE_SVector;
+/**
+ * \brief A contiguous growable array of pointers
+ */
+struct sce_svector {
+    void **data;                /**< Elements */
+    size_t size;                /**< Number of elements */
+    size_t capacity;            /**< Number of allocated elements */
+};
+
+typedef struct sce_svaluevector SCE_SValueVector;
+/**
+ * \brief A contiguous growable array of elements stored by value
+ */
+struct sce_svaluevector {
+    unsigned char *data;        /**< Elements */
+    size_t size;                /**< Number of elements */
+    size_t capacity;            /**< Number of allocated elements */
+    size_t elem_size;           /**< Size of one element */
+};
+
+/** @} */
+
+void SCE_Vector_Init (SCE_SVector*);
+void SCE_Vector_Clear (SCE_SVector*);
+SCE_SVector* SCE_Vector_Create (void);
+void SCE_Vector_Delete (SCE_SVector*);
+
+int SCE_Vector_Reserve (SCE_SVector*, size_t);
+void SCE_Vector_Flush (SCE_SVector*);
+int SCE_Vector_Push (SCE_SVector*, void*);
+void* SCE_Vector_Pop (SCE_SVector*);
+int SCE_Vector_Insert (SCE_SVector*, size_t, void*);
+void* SCE_Vector_Remove (SCE_SVector*, size_t);
+void* SCE_Vector_SwapRemove (SCE_SVector*, size_t);
+size_t SCE_Vector_Locate (const SCE_SVector*, const void*);
+int SCE_Vector_Sort (SCE_SVector*, SCE_FListCompareData);
+size_t SCE_Vector_GetSize (const SCE_SVector*);
+
+void SCE_ValueVector_Init (SCE_SValueVector*, size_t);
+void SCE_ValueVector_Clear (SCE_SValueVector*);
+SCE_SValueVector* SCE_ValueVector_Create (size_t);
+void SCE_ValueVector_Delete (SCE_SValueVector*);
+
+int SCE_ValueVector_Reserve (SCE_SValueVector*, size_t);
+void SCE_ValueVector_Flush (SCE_SValueVector*);
+int SCE_ValueVector_Push (SCE_SValueVector*, const void*);
+int SCE_ValueVector_Pop (SCE_SValueVector*, void*);
+int SCE_ValueVector_Insert (SCE_SValueVector*, size_t, const void*);
+void SCE_ValueVector_Remove (SCE_SValueVector*, size_t);
+void SCE_ValueVector_SwapRemove (SCE_SValueVector*, size_t);
+int SCE_ValueVector_Sort (SCE_SValueVector*, SCE_FListCompareData);
+size_t SCE_ValueVector_GetSize (const SCE_SValueVector*);
+
+/** \brief Value returned by SCE_Vector_Locate() when nothing is found */
+#define SCE_VECTOR_NOT_FOUND ((size_t)-1)
+
+/**
+ * \brief Gets the element \p i of a vector
+ */
+#define SCE_Vector_Get(v, i) ((v)->data[(i)])
+/**
+ * \brief Gets a pointer to the element \p i of a value vector
+ */
+#define SCE_ValueVector_Get(v, i)\
+    ((void*)((v)->data + (i) * (v)->elem_size))
+
+/**
+ * \brief Loops over a vector, \p it is a void** pointing to each element
+ */
+#define SCE_Vector_ForEach(it, v)\
+    for ((it) = (v)->data; (it) < (v)->data + (v)->size; (it)++)
+/**
+ * \brief Loops backwards over a vector, the current element can be removed
+ * \param pro a size_t, index of the current element
+ */
+#define SCE_Vector_ForEachProtected(pro, it, v)\
+    for ((pro) = (v)->size;\
+         (pro)-- > 0 && ((it) = &(v)->data[(pro)], 1);)
+
+/**
+ * \brief Loops over a value vector, \p it is a pointer to the type of the
+ * elements
+ */
+#define SCE_ValueVector_ForEach(it, v)\
+    for ((it) = (void*)(v)->data;\
+         (unsigned char*)(it) < (v)->data + (v)->size * (v)->elem_size;\
+         (it)++)
+/**
+ * \brief Loops backwards over a value vector, the current element can be
+ * removed
+ * \param pro a size_t, index of the current element
+ */
+#define SCE_ValueVector_ForEachProtected(pro, it, v)\
+    for ((pro) = (v)->size;\
+         (pro)-- > 0 && ((it) = SCE_ValueVector_Get ((v), (pro)), 1);)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,87 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEHEAP_H
+#define SCEHEAP_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup heap
+ * @{
+ */
+
+/** \brief Index given to SCE_FHeapMoveFunc when an element leaves a heap */
+#define SCE_HEAP_NO_INDEX ((size_t)-1)
+/** \brief Maximum arity of a heap */
+#define SCE_HEAP_MAX_ARITY 16
+
+/**
+ * \brief Called when an element of a heap changes of index
+ * \param data the element
+ * \param index its new index, or SCE_HEAP_NO_INDEX if it has been removed
+ */
+typedef void (*SCE_FHeapMoveFunc)(void *data, size_t index);
+
+typedef struct sce_sheap SCE_SHeap;
+/**
+ * \brief A d-ary heap of pointers
+ */
+struct sce_sheap {
+    void **data;                /**< Elements */
+    size_t size;                /**< Number of elements */
+    size_t capacity;            /**< Number of allocated elements */
+    unsigned int arity;         /**< Number of children per node */
+    SCE_FListCompareData cmp;   /**< Orders the elements */
+    SCE_FHeapMoveFunc move;     /**< Reports the indices, can be NULL */
+};
+
+/** @} */
+
+void SCE_Heap_Init (SCE_SHeap*, SCE_FListCompareData);
+void SCE_Heap_Clear (SCE_SHeap*);
+SCE_SHeap* SCE_Heap_Create (SCE_FListCompareData);
+void SCE_Heap_Delete (SCE_SHeap*);
+
+void SCE_Heap_SetArity (SCE_SHeap*, unsigned int);
+void SCE_Heap_SetMoveFunc (SCE_SHeap*, SCE_FHeapMoveFunc);
+
+int SCE_Heap_Reserve (SCE_SHeap*, size_t);
+void SCE_Heap_Flush (SCE_SHeap*);
+int SCE_Heap_Push (SCE_SHeap*, void*);
+int SCE_Heap_PushAll (SCE_SHeap*, void**, size_t);
+void* SCE_Heap_Peek (const SCE_SHeap*);
+void* SCE_Heap_Pop (SCE_SHeap*);
+void SCE_Heap_Update (SCE_SHeap*, size_t);
+void* SCE_Heap_Remove (SCE_SHeap*, size_t);
+size_t SCE_Heap_GetSize (const SCE_SHeap*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
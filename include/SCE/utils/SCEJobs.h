@@ -0,0 +1,85 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+#ifndef SCEJOBS_H
+#define SCEJOBS_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup jobs
+ * @{
+ */
+
+/** \brief Maximum number of worker threads */
+#define SCE_JOBS_MAX_THREADS 64
+
+typedef struct sce_sjob SCE_SJob;
+/**
+ * \brief Function of a job
+ * \param job the running job, can be given as parent to new jobs
+ * \param data user data of \p job
+ */
+typedef void (*SCE_FJobFunc)(SCE_SJob *job, void *data);
+/**
+ * \brief Function running a part of a SCE_Jobs_ParallelFor()
+ * \param begin first index of the part
+ * \param end index following the last one of the part
+ * \param data user data
+ */
+typedef void (*SCE_FJobRangeFunc)(size_t begin, size_t end, void *data);
+
+/**
+ * \brief A job, its storage is owned by the caller
+ */
+struct sce_sjob {
+    SCE_FJobFunc func;          /**< Function, can be NULL */
+    void *data;                 /**< User data */
+    SCE_SJob *parent;           /**< Job waiting for this one, or NULL */
+    unsigned int pending;       /**< 1 until \c func returned, plus the
+                                 * number of unfinished children */
+};
+
+/** @} */
+
+int SCE_Init_Jobs (void);
+void SCE_Quit_Jobs (void);
+
+unsigned int SCE_Jobs_GetCount (void);
+
+void SCE_Job_Init (SCE_SJob*, SCE_FJobFunc, void*);
+void SCE_Job_SetParent (SCE_SJob*, SCE_SJob*);
+void SCE_Job_Run (SCE_SJob*);
+void SCE_Job_Wait (SCE_SJob*);
+int SCE_Job_IsDone (SCE_SJob*);
+
+void SCE_Jobs_ParallelFor (size_t, size_t, size_t, SCE_FJobRangeFunc, void*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
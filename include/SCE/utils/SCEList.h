@@ -17,11 +17,13 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 21/09/2007
-   updated: 14/03/2012 */
+   updated: 18/10/2026 */
 
 #ifndef SCELIST_H
 #define SCELIST_H
 
+#include "SCE/utils/SCEPool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,6 +36,7 @@ extern "C" {
 /** \copydoc sce_slist */
 typedef struct sce_slist SCE_SList;
 typedef struct sce_slistiterator SCE_SListIterator;
+typedef struct sce_slistindex SCE_SListIndex;
 
 struct sce_slistiterator {
     SCE_SListIterator *next, *prev;
@@ -57,6 +60,11 @@ struct sce_slist {
     SCE_FListFreeFunc2 f2;    /**< Second free function */
     void *f2arg;              /**< \c f2 first argument */
     int canfree;              /**< Does the list can delete iterators? */
+    SCE_SPool *pool;          /**< Pool of the iterators, if any */
+    unsigned int length;      /**< Cached number of elements */
+    unsigned long long epoch; /**< Validity of \c length, see
+                               * SCE_List_GetLength() */
+    SCE_SListIndex *index;    /**< Data index, see SCE_List_EnableIndex() */
 };
 
 /** @} */
@@ -77,6 +85,11 @@ void SCE_List_Delete (SCE_SList*);
 void SCE_List_CanDeleteIterators (SCE_SList*, int);
 void SCE_List_SetFreeFunc (SCE_SList*, SCE_FListFreeFunc);
 void SCE_List_SetFreeFunc2 (SCE_SList*, SCE_FListFreeFunc2, void*);
+void SCE_List_SetPool (SCE_SList*, SCE_SPool*);
+SCE_SPool* SCE_List_GetPool (const SCE_SList*);
+int SCE_List_EnableIndex (SCE_SList*);
+void SCE_List_DisableIndex (SCE_SList*);
+void SCE_List_SetDirty (SCE_SList*);
 
 int SCE_List_IsAttached (const SCE_SListIterator*);
 
@@ -95,6 +108,7 @@ void SCE_List_AppendAll (SCE_SList*, SCE_SList*);
 
 void SCE_List_Remove (SCE_SListIterator*);
 void SCE_List_Removel (SCE_SListIterator*);
+void SCE_List_Detach (SCE_SList*, SCE_SListIterator*);
 SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList*);
 SCE_SListIterator* SCE_List_RemoveLast (SCE_SList*);
 
@@ -114,6 +128,7 @@ void SCE_List_BreakAll (SCE_SList*);
 void SCE_List_Extract (SCE_SList*);
 
 void* SCE_List_SetData (SCE_SListIterator*, void*);
+void* SCE_List_SetDatal (SCE_SList*, SCE_SListIterator*, void*);
 #if 0
 void* SCE_List_GetData (SCE_SListIterator*);
 #endif
@@ -143,6 +158,7 @@ void SCE_List_QuickSortRange (SCE_SList*, unsigned int, unsigned int,
                               SCE_FListCompareData);
 void SCE_List_QuickSort (SCE_SList*, SCE_FListCompareData);
 void SCE_List_GnomeSort (SCE_SList*, SCE_FListCompareData);
+void SCE_List_MergeSort (SCE_SList*, SCE_FListCompareData);
 
 /**
  * \brief Sorts a list
@@ -155,10 +171,11 @@ void SCE_List_GnomeSort (SCE_SList*, SCE_FListCompareData);
  * \warning Do NOT consider this macro expands to what it expands now, it may
  *          change later.
  * 
+ * \see SCE_List_MergeSort()
  * \see SCE_List_QuickSort()
  * \see SCE_List_GnomeSort()
  */
-#define SCE_List_Sort(l, func) (SCE_List_GnomeSort ((l), (func)))
+#define SCE_List_Sort(l, func) (SCE_List_MergeSort ((l), (func)))
 
 /**
  * \brief Gets data of an iterator
@@ -175,6 +192,7 @@ do {\
     ((SCE_SListIterator*)(it))->next = ((SCE_SList*)(l))->first.next;   \
     ((SCE_SList*)(l))->first.next->prev = ((SCE_SListIterator*)(it));   \
     ((SCE_SList*)(l))->first.next = ((SCE_SListIterator*)(it));         \
+    SCE_List_SetDirty ((SCE_SList*)(l));                                \
 } while (0)
 
 #define SCE_List_Appendl(l, it)\
@@ -183,8 +201,11 @@ do {\
     ((SCE_SListIterator*)(it))->prev = ((SCE_SList*)(l))->last.prev;    \
     ((SCE_SList*)(l))->last.prev->next = ((SCE_SListIterator*)(it));    \
     ((SCE_SList*)(l))->last.prev = ((SCE_SListIterator*)(it));          \
+    SCE_List_SetDirty ((SCE_SList*)(l));                                \
 } while (0)
 
+/* does not invalidate the cached length, use SCE_List_Detach() on lists
+   whose length is queried */
 #define SCE_List_Removel(it)\
 do {\
     ((SCE_SListIterator*)(it))->next->prev = ((SCE_SListIterator*)(it))->prev; \
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 26/01/2009
-   updated: 27/01/2009 */
+   updated: 17/10/2026 */
 
 #ifndef SCELISTFASTFOREACH_H
 #define SCELISTFASTFOREACH_H
@@ -33,6 +33,11 @@ typedef void (*SCE_FListFastForeach)(SCE_SListIterator*, void*);
 typedef void (*SCE_FListFastForeach2)(void*, void*);
 typedef void (*SCE_FListFastForeach3)(SCE_SListIterator*);
 typedef void (*SCE_FListFastForeach4)(void*);
+typedef void (*SCE_FListBatchForeach)(void**, unsigned int, void*);
+
+/** \brief Maximum number of elements given at once to a
+ * SCE_FListBatchForeach */
+#define SCE_LIST_MAX_BATCH 64
 
 int SCE_Init_FastList (void);
 void SCE_Quit_FastList (void);
@@ -46,6 +51,20 @@ void SCE_List_FastForEach3 (SCE_SList*, unsigned int,
 void SCE_List_FastForEach4 (SCE_SList*, unsigned int,
                            SCE_FListFastForeach4);
 
+void SCE_List_PrefetchForEach2 (SCE_SList*, unsigned int,
+                                SCE_FListFastForeach2, void*);
+void SCE_List_BatchForEach (SCE_SList*, unsigned int, unsigned int,
+                            SCE_FListBatchForeach, void*);
+
+void SCE_List_ParallelForEach (SCE_SList*, unsigned int, unsigned int,
+                               SCE_FListFastForeach, void*);
+void SCE_List_ParallelForEach2 (SCE_SList*, unsigned int, unsigned int,
+                                SCE_FListFastForeach2, void*);
+void SCE_List_ParallelForEach3 (SCE_SList*, unsigned int, unsigned int,
+                                SCE_FListFastForeach3);
+void SCE_List_ParallelForEach4 (SCE_SList*, unsigned int, unsigned int,
+                                SCE_FListFastForeach4);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 13/02/2009
-   updated: 10/04/2010 */
+   updated: 17/10/2026 */
 
 #ifndef SCEMACROS_H
 #define SCEMACROS_H
@@ -105,6 +105,12 @@ extern "C" {
 #define SCE_GNUC_ALLOC_SIZE2(x,y)
 #endif
 
+#if     (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define SCE_GNUC_ALLOC_ALIGN(x) __attribute__((__alloc_align__(x)))
+#else
+#define SCE_GNUC_ALLOC_ALIGN(x)
+#endif
+
 #if     __GNUC__ > 2 || (__GNUC__ == 2 && __GNUC_MINOR__ > 4)
 #define SCE_GNUC_PRINTF( format_idx, arg_idx )    \
   __attribute__((__format__ (__printf__, format_idx, arg_idx)))
@@ -173,6 +179,35 @@ extern "C" {
 #  define SCE_GNUC_NONNULL3
 #endif
 
+/**
+ * \addtogroup utils
+ * \def SCE_PREFETCH
+ * \brief Hints the processor to load the cache line of \p addr
+ */
+#if   __GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 1)
+#  define SCE_PREFETCH(addr)            __builtin_prefetch (addr)
+#else
+#  define SCE_PREFETCH(addr)
+#endif
+
+/**
+ * \addtogroup utils
+ * \brief Size of a cache line in bytes, assumed for padding shared data
+ */
+#define SCE_CACHE_LINE_SIZE 64
+/**
+ * \addtogroup utils
+ * \def SCE_CACHE_ALIGNED
+ * \brief Aligns a variable or a structure member on a cache line, so that
+ * data written by different threads does not share a line
+ */
+#if   __GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 1)
+#  define SCE_CACHE_ALIGNED \
+    __attribute__ ((aligned (SCE_CACHE_LINE_SIZE)))
+#else
+#  define SCE_CACHE_ALIGNED
+#endif
+
 
 #ifdef __cplusplus
 } /* extern "C" */
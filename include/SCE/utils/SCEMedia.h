@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 05/01/2007
-   updated: 25/06/2011 */
+   updated: 18/10/2026 */
 
 #ifndef SCEMEDIA_H
 #define SCEMEDIA_H
@@ -54,6 +54,7 @@ int SCE_Media_Register (int, const char*, SCE_FMediaLoadFunc,
                         SCE_FMediaSaveFunc);
 
 void* SCE_Media_Load (int, const char*, void*);
+int SCE_Media_LoadMany (int, const char**, void**, size_t, void*);
 int SCE_Media_Save (int, void*, const char*);
 
 #ifdef __cplusplus
@@ -17,11 +17,12 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 22/12/2006
-   updated: 23/10/2008 */
+   updated: 17/10/2026 */
 
 #ifndef SCEMEMORY_H
 #define SCEMEMORY_H
 
+#include <stdio.h>
 #include <stdlib.h>
 #include "SCE/utils/SCEMacros.h"
 
@@ -38,47 +39,191 @@ extern "C" {
  * \brief Main malloc wrapper
  * \see SCE_Mem_Alloc()
  */
-#ifdef SCE_DEBUG
-#define SCE_malloc(size) SCE_Mem_Alloc(__FILE__, __LINE__, size)
-#else
-#define SCE_malloc(size) malloc(size)
-#endif
+#define SCE_malloc(size) SCE_Mem_Alloc (__FILE__, __LINE__, size)
 /**
  * \brief Main calloc wrapper
  * \see SCE_Mem_Calloc()
  */
-#ifdef SCE_DEBUG
-#define SCE_calloc(size, nb) SCE_Mem_Calloc(__FILE__, __LINE__, size, nb)
-#else
-#define SCE_calloc(size, nb) calloc(size, nb)
-#endif
+#define SCE_calloc(size, nb) SCE_Mem_Calloc (__FILE__, __LINE__, size, nb)
 /**
  * \brief Main realloc wrapper
  * \see SCE_Mem_Realloc()
  */
-#ifdef SCE_DEBUG
-#define SCE_realloc(ptr, size) SCE_Mem_Realloc(__FILE__, __LINE__, ptr, size)
-#else
-#define SCE_realloc(ptr, size) realloc(ptr, size)
-#endif
+#define SCE_realloc(ptr, size) SCE_Mem_Realloc (__FILE__, __LINE__, ptr, size)
 /**
  * \brief Main free wrapper
- * \see SCE_Mem_Free()
- * \note This macro is guaranteed to expand to a function. It means that it is
- *       possible to use it exactly as a function, including passing it as
- *       argument of another function taking a function pointer and so on.
+ * \see SCE_Mem_Free(), SCE_Mem_Release()
+ * \note In non-debug builds this macro is guaranteed to expand to a function.
+ *       It means that it is possible to use it exactly as a function,
+ *       including passing it as argument of another function taking a
+ *       function pointer and so on.
+ * \warning Memory returned by SCE_malloc() and friends must be released with
+ *          SCE_free() and never with the libc's free().
  */
 #ifdef SCE_DEBUG
 #define SCE_free(p) SCE_Mem_Free (__FILE__, __LINE__, p)
 #else
-#define SCE_free free
+#define SCE_free SCE_Mem_Release
 #endif
 
+/**
+ * \brief Allocates a block aligned on \p align bytes
+ * \see SCE_Mem_AllocAligned()
+ */
+#define SCE_malloc_aligned(align, size)\
+    SCE_Mem_AllocAligned (__FILE__, __LINE__, align, size)
+/**
+ * \brief Reallocates a block, the new block is aligned on \p align bytes
+ * \see SCE_Mem_ReallocAligned()
+ */
+#define SCE_realloc_aligned(ptr, align, size)\
+    SCE_Mem_ReallocAligned (__FILE__, __LINE__, ptr, align, size)
+/**
+ * \brief Frees a block allocated by SCE_malloc_aligned()
+ * \see SCE_Mem_FreeAligned()
+ */
+#define SCE_free_aligned(p) SCE_Mem_FreeAligned (__FILE__, __LINE__, p)
+
+/**
+ * \brief Allocates a block accounted to the memory tag \p tag, free it
+ * with SCE_free()
+ * \see SCE_Mem_AllocTagged()
+ */
+#define SCE_malloc_tagged(tag, size)\
+    SCE_Mem_AllocTagged (__FILE__, __LINE__, tag, size)
+
+typedef void* (*SCE_FMemAllocFunc)(void*, size_t);
+typedef void* (*SCE_FMemCallocFunc)(void*, size_t, size_t);
+typedef void* (*SCE_FMemReallocFunc)(void*, void*, size_t);
+typedef void (*SCE_FMemFreeFunc)(void*, void*);
+typedef void* (*SCE_FMemAllocAlignedFunc)(void*, size_t, size_t);
+
+typedef struct sce_smemallocator SCE_SMemAllocator;
+/**
+ * \brief An allocator the library can be routed to, the first argument of
+ * every function is \c data
+ * \see SCE_Mem_SetAllocator()
+ */
+struct sce_smemallocator {
+    SCE_FMemAllocFunc alloc;            /**< Like malloc() */
+    SCE_FMemCallocFunc calloc;          /**< Like calloc(), optional */
+    SCE_FMemReallocFunc realloc;        /**< Like realloc() */
+    SCE_FMemFreeFunc free;              /**< Like free() */
+    SCE_FMemAllocAlignedFunc alloc_aligned; /**< Takes the alignment then
+                                             * the size, optional */
+    SCE_FMemFreeFunc free_aligned;      /**< Frees the blocks of
+                                         * \c alloc_aligned */
+    void *data;                         /**< User data */
+};
+
+/** \brief Number of memory tags */
+#define SCE_MEM_NUM_TAGS 64
+
+/**
+ * \brief Memory tags of the library, see SCE_Mem_AllocTagged()
+ *
+ * Applications can use any tag from SCE_MEM_TAG_USER to SCE_MEM_NUM_TAGS - 1.
+ */
+enum sce_ememtag {
+    SCE_MEM_TAG_NONE = 0,       /**< Not accounted */
+    SCE_MEM_TAG_RESOURCE,       /**< Resource manager */
+    SCE_MEM_TAG_MEDIA,          /**< Media loaders */
+    SCE_MEM_TAG_MATH,           /**< Math scratch buffers */
+    SCE_MEM_TAG_USER            /**< First tag free for applications */
+};
+typedef enum sce_ememtag SCE_EMemTag;
+
+/**
+ * \brief Budgets of a memory tag
+ * \see SCE_Mem_SetTagBudget()
+ */
+enum sce_emembudget {
+    SCE_MEM_BUDGET_SOFT,
+    SCE_MEM_BUDGET_HARD
+};
+typedef enum sce_emembudget SCE_EMemBudget;
+
+/**
+ * \brief Called when a budget is exceeded, with the tag, the exceeded
+ * budget, the bytes in use, the bytes asked and the user data
+ * \see SCE_Mem_SetBudgetCallback()
+ */
+typedef void (*SCE_FMemBudgetFunc)(unsigned int, SCE_EMemBudget, long, long,
+                                   void*);
+
+typedef struct sce_smemtagstats SCE_SMemTagStats;
+/**
+ * \brief Counters of a memory tag
+ * \see SCE_Mem_GetTagStats()
+ */
+struct sce_smemtagstats {
+    const char *name;           /**< Name of the tag */
+    long live;                  /**< Bytes currently allocated */
+    long peak;                  /**< Highest value reached by \c live */
+    size_t n_allocs;            /**< Number of allocations */
+    size_t n_frees;             /**< Number of frees */
+    size_t soft;                /**< Soft budget, 0 if none */
+    size_t hard;                /**< Hard budget, 0 if none */
+};
+
+typedef struct sce_smemsite SCE_SMemSite;
+/**
+ * \brief Allocation statistics of a callsite
+ */
+struct sce_smemsite {
+    const char *file;           /**< File of the callsite */
+    unsigned int line;          /**< Line of the callsite */
+    size_t n_allocs;            /**< Number of allocations */
+    size_t n_frees;             /**< Number of frees */
+    long live;                  /**< Bytes currently allocated */
+    long peak;                  /**< Highest value reached by \c live */
+    size_t total;               /**< Bytes allocated so far, ie. churn */
+};
+
+typedef struct sce_smemsnapshot SCE_SMemSnapshot;
+/**
+ * \brief Copy of the statistics of all the callsites at a given time
+ */
+struct sce_smemsnapshot {
+    SCE_SMemSite *sites;
+    size_t n_sites;
+};
+
+/**
+ * \brief Counters of SCE_SMemSite a snapshot can be sorted on
+ * \see SCE_Mem_SortSnapshot()
+ */
+enum sce_ememsitekey {
+    SCE_MEM_SITE_LIVE,
+    SCE_MEM_SITE_PEAK,
+    SCE_MEM_SITE_TOTAL,
+    SCE_MEM_SITE_ALLOCS
+};
+typedef enum sce_ememsitekey SCE_EMemSiteKey;
+
+/** \brief Pages of regions of at least this size are backed by huge pages
+ * when the system allows it */
+#define SCE_MEM_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+typedef struct sce_smemregion SCE_SMemRegion;
+/**
+ * \brief A range of reserved address space, committed on demand
+ * \see SCE_Mem_ReserveRegion()
+ */
+struct sce_smemregion {
+    unsigned char *base;        /**< Start of the region, never moves */
+    size_t reserved;            /**< Size of the reserved address space */
+    size_t committed;           /**< Bytes usable from \c base */
+};
+
 /** @} */
 
 int SCE_Init_Mem (void);
 void SCE_Quit_Mem (void);
 
+int SCE_Mem_SetAllocator (const SCE_SMemAllocator*);
+const SCE_SMemAllocator* SCE_Mem_GetAllocator (void);
+
 void* SCE_Mem_Alloc (const char*, unsigned int, size_t)
     SCE_GNUC_MALLOC
     SCE_GNUC_ALLOC_SIZE (3);
@@ -88,11 +233,48 @@ void* SCE_Mem_Calloc (const char*, unsigned int, size_t, size_t)
 void* SCE_Mem_Realloc (const char*, unsigned int, void*, size_t)
     SCE_GNUC_ALLOC_SIZE (4);
 void SCE_Mem_Free (const char*, int, void*);
+void SCE_Mem_Release (void*);
+
+void* SCE_Mem_AllocAligned (const char*, unsigned int, size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_ALIGN (3)
+    SCE_GNUC_ALLOC_SIZE (4);
+void* SCE_Mem_ReallocAligned (const char*, unsigned int, void*, size_t, size_t)
+    SCE_GNUC_ALLOC_ALIGN (4)
+    SCE_GNUC_ALLOC_SIZE (5);
+void SCE_Mem_FreeAligned (const char*, int, void*);
+
+void* SCE_Mem_AllocTagged (const char*, unsigned int, unsigned int, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (4);
+void SCE_Mem_SetTagName (unsigned int, const char*);
+void SCE_Mem_SetTagBudget (unsigned int, size_t, size_t);
+void SCE_Mem_SetBudgetCallback (unsigned int, SCE_FMemBudgetFunc, void*);
+void SCE_Mem_GetTagStats (unsigned int, SCE_SMemTagStats*);
 
 void* SCE_Mem_Dup (const void*, size_t)
     SCE_GNUC_MALLOC
     SCE_GNUC_ALLOC_SIZE (2);
 
+void SCE_Mem_SetSampleRate (size_t);
+size_t SCE_Mem_GetSampleRate (void);
+
+void SCE_Mem_InitSnapshot (SCE_SMemSnapshot*);
+void SCE_Mem_ClearSnapshot (SCE_SMemSnapshot*);
+int SCE_Mem_TakeSnapshot (SCE_SMemSnapshot*);
+int SCE_Mem_DiffSnapshots (const SCE_SMemSnapshot*, const SCE_SMemSnapshot*,
+                           SCE_SMemSnapshot*);
+void SCE_Mem_SortSnapshot (SCE_SMemSnapshot*, SCE_EMemSiteKey);
+int SCE_Mem_WriteSnapshot (const SCE_SMemSnapshot*, FILE*);
+void SCE_Mem_ResetPeaks (void);
+
+void SCE_Mem_InitRegion (SCE_SMemRegion*);
+void SCE_Mem_ClearRegion (SCE_SMemRegion*);
+int SCE_Mem_ReserveRegion (SCE_SMemRegion*, size_t);
+int SCE_Mem_CommitRegion (SCE_SMemRegion*, size_t);
+void* SCE_Mem_GetRegionData (const SCE_SMemRegion*);
+size_t SCE_Mem_GetRegionSize (const SCE_SMemRegion*);
+
 #ifdef SCE_DEBUG
 int SCE_Mem_IsValid (void*);
 void SCE_Mem_List (void);
@@ -0,0 +1,89 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#ifndef SCEPOOL_H
+#define SCEPOOL_H
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "SCE/utils/SCEMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup pool
+ * @{
+ */
+
+/** \brief Default size in bytes of the slabs of a pool */
+#define SCE_POOL_SLAB_SIZE 16384
+
+typedef struct sce_spoolslab SCE_SPoolSlab;
+/**
+ * \brief A slab of a pool, its objects follow the structure
+ */
+struct sce_spoolslab {
+    SCE_SPoolSlab *next;
+    size_t n_objects;           /**< Number of objects of the slab */
+};
+
+typedef struct sce_spool SCE_SPool;
+/**
+ * \brief A fixed-size objects allocator
+ */
+struct sce_spool {
+    size_t obj_size;            /**< Size of the objects, rounded */
+    size_t n_per_slab;          /**< Number of objects per slab */
+    SCE_SPoolSlab *first;       /**< First slab */
+    SCE_SPoolSlab *current;     /**< Slab being filled */
+    size_t n_taken;             /**< Objects taken from \c current */
+    void *free;                 /**< Free list of recycled objects */
+    size_t n_used;              /**< Number of objects in use */
+    unsigned int tag;           /**< Memory tag of the slabs */
+    int safe;                   /**< Is the pool thread-safe? */
+    pthread_mutex_t mutex;      /**< Used when \c safe is SCE_TRUE */
+};
+
+/** @} */
+
+void SCE_Pool_Init (SCE_SPool*, size_t);
+void SCE_Pool_Clear (SCE_SPool*);
+SCE_SPool* SCE_Pool_Create (size_t);
+void SCE_Pool_Delete (SCE_SPool*);
+
+void SCE_Pool_SetThreadSafe (SCE_SPool*, int);
+void SCE_Pool_SetSlabSize (SCE_SPool*, size_t);
+void SCE_Pool_SetTag (SCE_SPool*, unsigned int);
+
+void* SCE_Pool_Alloc (SCE_SPool*) SCE_GNUC_MALLOC;
+void SCE_Pool_Free (SCE_SPool*, void*);
+void SCE_Pool_FreeAll (SCE_SPool*);
+
+size_t SCE_Pool_GetObjectSize (const SCE_SPool*);
+size_t SCE_Pool_GetUsed (const SCE_SPool*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,135 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEQUEUE_H
+#define SCEQUEUE_H
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup queue
+ * @{
+ */
+
+typedef struct sce_smpscqueue SCE_SMPSCQueue;
+/**
+ * \brief Lock-free multi-producer single-consumer queue of list iterators
+ */
+struct sce_smpscqueue {
+    SCE_SListIterator *head;    /**< Last pushed iterator, producers side */
+    SCE_SListIterator *tail;    /**< Next iterator to pop, consumer side */
+    SCE_SListIterator stub;     /**< Placeholder keeping the queue non
+                                 * empty */
+};
+
+typedef struct sce_sringwait SCE_SRingWait;
+/**
+ * \brief Sleeping side of the ring buffers, used by the blocking calls only
+ */
+struct sce_sringwait {
+    int waiters;                /**< Non zero when threads may sleep */
+    int closed;                 /**< See SCE_SPSCRing_Close() */
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+typedef struct sce_sspscring SCE_SSPSCRing;
+/**
+ * \brief Wait-free bounded single-producer single-consumer ring buffer
+ */
+struct sce_sspscring {
+    SCE_CACHE_ALIGNED size_t head; /**< Pushed items, producer side */
+    size_t tail_cache;          /**< Last \c tail seen by the producer */
+    SCE_CACHE_ALIGNED size_t tail; /**< Popped items, consumer side */
+    size_t head_cache;          /**< Last \c head seen by the consumer */
+    SCE_CACHE_ALIGNED void **slots; /**< Items */
+    size_t mask;                /**< Capacity - 1 */
+    SCE_SRingWait wait;
+};
+
+typedef struct sce_sringcell SCE_SRingCell;
+/**
+ * \brief A slot of SCE_SMPMCRing
+ */
+struct sce_sringcell {
+    size_t seq;                 /**< Ticket the cell is ready for */
+    void *data;                 /**< Item */
+};
+
+typedef struct sce_smpmcring SCE_SMPMCRing;
+/**
+ * \brief Lock-free bounded multi-producer multi-consumer ring buffer
+ */
+struct sce_smpmcring {
+    SCE_CACHE_ALIGNED size_t head; /**< Next push ticket */
+    SCE_CACHE_ALIGNED size_t tail; /**< Next pop ticket */
+    SCE_CACHE_ALIGNED SCE_SRingCell *cells; /**< Items */
+    size_t mask;                /**< Capacity - 1 */
+    SCE_SRingWait wait;
+};
+
+/** @} */
+
+void SCE_MPSCQueue_Init (SCE_SMPSCQueue*);
+
+void SCE_MPSCQueue_Push (SCE_SMPSCQueue*, SCE_SListIterator*);
+SCE_SListIterator* SCE_MPSCQueue_Pop (SCE_SMPSCQueue*);
+unsigned int SCE_MPSCQueue_Drain (SCE_SMPSCQueue*, SCE_SList*);
+int SCE_MPSCQueue_IsEmpty (SCE_SMPSCQueue*);
+
+int SCE_SPSCRing_Init (SCE_SSPSCRing*, size_t);
+void SCE_SPSCRing_Clear (SCE_SSPSCRing*);
+SCE_SSPSCRing* SCE_SPSCRing_Create (size_t);
+void SCE_SPSCRing_Delete (SCE_SSPSCRing*);
+
+int SCE_SPSCRing_Push (SCE_SSPSCRing*, void*);
+void* SCE_SPSCRing_Pop (SCE_SSPSCRing*);
+size_t SCE_SPSCRing_PushN (SCE_SSPSCRing*, void**, size_t, int);
+size_t SCE_SPSCRing_PopN (SCE_SSPSCRing*, void**, size_t, int);
+void SCE_SPSCRing_Close (SCE_SSPSCRing*);
+size_t SCE_SPSCRing_GetSize (SCE_SSPSCRing*);
+size_t SCE_SPSCRing_GetCapacity (const SCE_SSPSCRing*);
+
+int SCE_MPMCRing_Init (SCE_SMPMCRing*, size_t);
+void SCE_MPMCRing_Clear (SCE_SMPMCRing*);
+SCE_SMPMCRing* SCE_MPMCRing_Create (size_t);
+void SCE_MPMCRing_Delete (SCE_SMPMCRing*);
+
+int SCE_MPMCRing_Push (SCE_SMPMCRing*, void*);
+void* SCE_MPMCRing_Pop (SCE_SMPMCRing*);
+size_t SCE_MPMCRing_PushN (SCE_SMPMCRing*, void**, size_t, int);
+size_t SCE_MPMCRing_PopN (SCE_SMPMCRing*, void**, size_t, int);
+void SCE_MPMCRing_Close (SCE_SMPMCRing*);
+size_t SCE_MPMCRing_GetSize (SCE_SMPMCRing*);
+size_t SCE_MPMCRing_GetCapacity (const SCE_SMPMCRing*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCERADIXSORT_H
+#define SCERADIXSORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup radixsort
+ * @{
+ */
+
+typedef struct sce_ssortkey32 SCE_SSortKey32;
+/**
+ * \brief An element to sort with a 32 bits key
+ */
+struct sce_ssortkey32 {
+    uint32_t key;               /**< Sort key, see SCE_Radix_FloatKey() */
+    void *data;                 /**< Element */
+};
+
+typedef struct sce_ssortkey64 SCE_SSortKey64;
+/**
+ * \brief An element to sort with a 64 bits key
+ */
+struct sce_ssortkey64 {
+    uint64_t key;               /**< Sort key, see SCE_Radix_DoubleKey() */
+    void *data;                 /**< Element */
+};
+
+/** \brief Gets the 32 bits sort key of an element of a list */
+typedef uint32_t (*SCE_FRadixKey32)(const void*);
+/** \brief Gets the 64 bits sort key of an element of a list */
+typedef uint64_t (*SCE_FRadixKey64)(const void*);
+
+/** \brief Minimum number of elements for the histograms to be computed by
+ * the worker threads */
+#define SCE_RADIX_PARALLEL_MIN (1 << 18)
+
+/** @} */
+
+uint32_t SCE_Radix_IntKey (int32_t) SCE_GNUC_CONST;
+uint32_t SCE_Radix_FloatKey (float) SCE_GNUC_CONST;
+uint64_t SCE_Radix_Int64Key (int64_t) SCE_GNUC_CONST;
+uint64_t SCE_Radix_DoubleKey (double) SCE_GNUC_CONST;
+
+int SCE_Radix_Sort32 (SCE_SSortKey32*, size_t, SCE_SSortKey32*);
+int SCE_Radix_Sort64 (SCE_SSortKey64*, size_t, SCE_SSortKey64*);
+
+int SCE_Radix_SortList32 (SCE_SList*, SCE_FRadixKey32);
+int SCE_Radix_SortList64 (SCE_SList*, SCE_FRadixKey64);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,138 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#ifndef SCEULIST_H
+#define SCEULIST_H
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup ulist
+ * @{
+ */
+
+/** \brief Number of elements stored in one node */
+#define SCE_ULIST_NODE_LENGTH 14
+
+typedef struct sce_sulistnode SCE_SUListNode;
+typedef struct sce_sulistit SCE_SUListIt;
+/**
+ * \brief A node of an unrolled list
+ *
+ * Elements are stored in \c data and never move between slots, their order
+ * is given by \c order.
+ */
+struct sce_sulistnode {
+    SCE_SUListNode *next, *prev;
+    unsigned short used;        /**< Mask of the used slots */
+    unsigned char n;            /**< Number of elements */
+    unsigned char order[SCE_ULIST_NODE_LENGTH]; /**< Slots, in list order */
+    void *data[SCE_ULIST_NODE_LENGTH];          /**< Elements */
+    SCE_SUListIt *its[SCE_ULIST_NODE_LENGTH];   /**< Tracked handles */
+};
+
+/**
+ * \brief Handle on an element of an unrolled list
+ */
+struct sce_sulistit {
+    SCE_SUListNode *node;       /**< Node of the element */
+    unsigned int slot;          /**< Slot of the element in \c node */
+    unsigned int pos;           /**< Position in \c node, hint only */
+};
+
+typedef struct sce_sulist SCE_SUList;
+/**
+ * \brief An unrolled list
+ */
+struct sce_sulist {
+    SCE_SUListNode *first;      /**< First node */
+    SCE_SUListNode *last;       /**< Last node */
+    size_t length;              /**< Number of elements */
+    SCE_FListFreeFunc f;        /**< Free function of the elements */
+};
+
+/** @} */
+
+void SCE_UList_Init (SCE_SUList*);
+void SCE_UList_Clear (SCE_SUList*);
+SCE_SUList* SCE_UList_Create (SCE_FListFreeFunc);
+void SCE_UList_Delete (SCE_SUList*);
+
+void SCE_UList_SetFreeFunc (SCE_SUList*, SCE_FListFreeFunc);
+
+int SCE_UList_Append (SCE_SUList*, void*, SCE_SUListIt*);
+int SCE_UList_Prepend (SCE_SUList*, void*, SCE_SUListIt*);
+int SCE_UList_InsertAfter (SCE_SUList*, SCE_SUListIt*, void*, SCE_SUListIt*);
+int SCE_UList_InsertBefore (SCE_SUList*, SCE_SUListIt*, void*,
+                            SCE_SUListIt*);
+void* SCE_UList_Remove (SCE_SUList*, SCE_SUListIt*);
+void SCE_UList_Erase (SCE_SUList*, SCE_SUListIt*);
+void SCE_UList_Untrack (SCE_SUListIt*);
+
+void SCE_UList_Join (SCE_SUList*, SCE_SUList*);
+int SCE_UList_Insert (SCE_SUList*, SCE_SUListIt*, SCE_SUList*);
+int SCE_UList_Extract (SCE_SUList*, SCE_SUListIt*, SCE_SUList*);
+
+size_t SCE_UList_GetLength (const SCE_SUList*);
+int SCE_UList_HasElements (const SCE_SUList*);
+int SCE_UList_GetFirst (const SCE_SUList*, SCE_SUListIt*);
+int SCE_UList_GetLast (const SCE_SUList*, SCE_SUListIt*);
+int SCE_UList_GetNext (SCE_SUListIt*);
+int SCE_UList_GetPrev (SCE_SUListIt*);
+
+/**
+ * \brief Gets the data of an element
+ * \param it a pointer to a SCE_SUListIt
+ */
+#define SCE_UList_GetData(it) ((it)->node->data[(it)->slot])
+
+/**
+ * \brief Loops over an unrolled list
+ * \param it a SCE_SUListIt, not a pointer
+ * \param l the list
+ */
+#define SCE_UList_ForEach(it, l)\
+    for ((it).node = (l)->first, (it).pos = 0;\
+         (it).node && ((it).slot = (it).node->order[(it).pos], 1);\
+         (void)(++(it).pos < (it).node->n ||\
+                ((it).node = (it).node->next, (it).pos = 0)))
+/**
+ * \brief Loops backwards over an unrolled list, the current element can be
+ * removed with SCE_UList_Remove() or SCE_UList_Erase()
+ * \param pro a SCE_SUListIt used internally
+ * \param it a SCE_SUListIt, not a pointer
+ * \param l the list
+ */
+#define SCE_UList_ForEachProtected(pro, it, l)\
+    for (SCE_UList_GetLast ((l), &(pro));\
+         (pro).node && ((it) = (pro), SCE_UList_GetPrev (&(pro)), 1);)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 13/02/2009
-   updated: 17/04/2010 */
+   updated: 18/10/2026 */
 
 #ifndef SCEUTILS_H
 #define SCEUTILS_H
@@ -31,6 +31,16 @@
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEArray.h"
+#include "SCE/utils/SCEArena.h"
+#include "SCE/utils/SCEPool.h"
+#include "SCE/utils/SCEDynVector.h"
+#include "SCE/utils/SCEUList.h"
+#include "SCE/utils/SCEWorkers.h"
+#include "SCE/utils/SCEQueue.h"
+#include "SCE/utils/SCEHeap.h"
+#include "SCE/utils/SCERadixSort.h"
+#include "SCE/utils/SCEChunkArray.h"
+#include "SCE/utils/SCEJobs.h"
 #include "SCE/utils/SCETime.h"
 #include "SCE/utils/SCEType.h"
 
@@ -54,6 +64,7 @@ extern "C" {
 #endif
 
 int SCE_Init_Utils (FILE*);
+int SCE_Init_Utils2 (FILE*, const SCE_SMemAllocator*);
 void SCE_Quit_Utils (void);
 
 #ifdef __cplusplus
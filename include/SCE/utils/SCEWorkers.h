@@ -0,0 +1,52 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#ifndef SCEWORKERS_H
+#define SCEWORKERS_H
+
+#include "SCE/utils/SCEMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup workers
+ * @{
+ */
+
+/**
+ * \brief Function running one task of a batch
+ * \param task index of the task, from 0 to the number of tasks - 1
+ * \param data user data given to SCE_Workers_Run()
+ */
+typedef void (*SCE_FWorkerFunc)(unsigned int task, void *data);
+
+/** @} */
+
+unsigned int SCE_Workers_GetCount (void);
+void SCE_Workers_Run (unsigned int, SCE_FWorkerFunc, void*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,392 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEArena.h"
+
+/**
+ * \file SCEArena.c
+ * \copydoc arena
+ * \brief Linear allocators
+ *
+ * \file SCEArena.h
+ * \copydoc arena
+ * \brief Linear allocators
+ */
+
+/**
+ * \defgroup arena Linear allocators
+ * \ingroup utils
+ * \brief Bump-pointer allocators for short-lived data
+ *
+ * An arena hands out memory by moving a pointer forward in a chain of big
+ * chunks. Blocks are never freed one by one: the whole arena is reset at
+ * once, or rolled back to a mark. This is meant for per-frame temporaries
+ * which would otherwise each cost a SCE_malloc() and a SCE_free().
+ */
+
+/** @{ */
+
+static pthread_once_t arena_once = PTHREAD_ONCE_INIT;
+static pthread_key_t arena_key;
+static __thread SCE_SArena *thread_arena = NULL;
+
+#ifdef SCE_DEBUG
+/* every live arena, to report those never reset */
+static SCE_SList arenas;
+static pthread_mutex_t arenas_m = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void SCE_Arena_DeleteThreadArena (void *a)
+{
+    SCE_Arena_Delete (a);
+    thread_arena = NULL;
+}
+
+static void SCE_Arena_InitOnce (void)
+{
+#ifdef SCE_DEBUG
+    SCE_List_Init (&arenas);
+#endif
+    pthread_key_create (&arena_key, SCE_Arena_DeleteThreadArena);
+}
+
+/**
+ * \brief Initializes the arenas manager
+ * \returns SCE_OK, this function can't fail
+ */
+int SCE_Init_Arena (void)
+{
+    pthread_once (&arena_once, SCE_Arena_InitOnce);
+    return SCE_OK;
+}
+/**
+ * \brief Quits the arenas manager
+ */
+void SCE_Quit_Arena (void)
+{
+}
+
+
+/**
+ * \brief Initializes an arena
+ * \param a the arena to initialize
+ *
+ * No memory is allocated until the first call to SCE_Arena_Alloc().
+ */
+void SCE_Arena_Init (SCE_SArena *a)
+{
+    a->first = a->current = NULL;
+    a->chunk_size = SCE_ARENA_CHUNK_SIZE;
+    a->n_resets = 0;
+    SCE_List_InitIt (&a->it);
+    SCE_List_SetData (&a->it, a);
+#ifdef SCE_DEBUG
+    pthread_once (&arena_once, SCE_Arena_InitOnce);
+    pthread_mutex_lock (&arenas_m);
+    SCE_List_Appendl (&arenas, &a->it);
+    pthread_mutex_unlock (&arenas_m);
+#endif
+}
+/**
+ * \brief Clears an arena, frees all its chunks
+ * \param a the arena to clear
+ */
+void SCE_Arena_Clear (SCE_SArena *a)
+{
+    SCE_SArenaChunk *c = NULL, *next = NULL;
+#ifdef SCE_DEBUG
+    pthread_mutex_lock (&arenas_m);
+    SCE_List_Detach (&arenas, &a->it);
+    pthread_mutex_unlock (&arenas_m);
+#endif
+    for (c = a->first; c; c = next) {
+        next = c->next;
+        SCE_free (c);
+    }
+    a->first = a->current = NULL;
+}
+/**
+ * \brief Creates a new arena
+ * \returns a newly allocated arena, or NULL on error
+ */
+SCE_SArena* SCE_Arena_Create (void)
+{
+    SCE_SArena *a = NULL;
+    if (!(a = SCE_malloc (sizeof *a)))
+        SCEE_LogSrc ();
+    else
+        SCE_Arena_Init (a);
+    return a;
+}
+/**
+ * \brief Deletes an arena created by SCE_Arena_Create()
+ * \param a the arena to delete
+ */
+void SCE_Arena_Delete (SCE_SArena *a)
+{
+    if (a) {
+        SCE_Arena_Clear (a);
+        SCE_free (a);
+    }
+}
+
+/**
+ * \brief Sets the minimum size of the chunks allocated by an arena
+ * \param a an arena
+ * \param size size of the new chunks, in bytes
+ *
+ * Chunks already allocated are kept. Requests bigger than \p size get
+ * a chunk of their own.
+ */
+void SCE_Arena_SetChunkSize (SCE_SArena *a, size_t size)
+{
+    a->chunk_size = size;
+}
+
+
+#define SCE_Arena_GetChunkData(c) ((unsigned char*)&((SCE_SArenaChunk*)(c))[1])
+
+static SCE_SArenaChunk* SCE_Arena_CreateChunk (size_t size)
+{
+    SCE_SArenaChunk *c = NULL;
+    if (size > SIZE_MAX - sizeof *c) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        SCEE_LogMsg ("arena chunk of %lu bytes overflows",
+                     (unsigned long)size);
+    } else if (!(c = SCE_malloc (sizeof *c + size)))
+        SCEE_LogSrc ();
+    else {
+        c->next = NULL;
+        c->size = size;
+        c->used = 0;
+    }
+    return c;
+}
+
+static void* SCE_Arena_AllocInChunk (SCE_SArenaChunk *c, size_t align,
+                                     size_t size)
+{
+    size_t base = (size_t)SCE_Arena_GetChunkData (c);
+    /* offsets in the chunk, they cannot overflow */
+    size_t pad = (0 - (base + c->used)) & (align - 1);
+    size_t start;
+    if (pad > c->size - c->used)
+        return NULL;
+    start = c->used + pad;
+    if (size > c->size - start)
+        return NULL;
+    c->used = start + size;
+    return (void*)(base + start);
+}
+
+/**
+ * \brief Allocates aligned memory from an arena
+ * \param a an arena
+ * \param align alignment of the returned block, must be a power of two
+ * \param size size of the block, in bytes
+ * \returns the new block, or NULL on error
+ *
+ * The block lives until the next call to SCE_Arena_Reset(), SCE_Arena_Clear()
+ * or SCE_Arena_PopMark() with a mark taken before this call.
+ */
+void* SCE_Arena_AllocAligned (SCE_SArena *a, size_t align, size_t size)
+{
+    SCE_SArenaChunk *c = NULL;
+    void *p = NULL;
+
+    if (!align || (align & (align - 1))) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("arena alignment must be a power of two, got %zu", align);
+        return NULL;
+    }
+    if (size > SIZE_MAX - align) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        SCEE_LogMsg ("arena allocation of %lu bytes aligned on %lu overflows",
+                     (unsigned long)size, (unsigned long)align);
+        return NULL;
+    }
+    if (a->current && (p = SCE_Arena_AllocInChunk (a->current, align, size)))
+        return p;
+
+    /* reuse the next chunk when it is big enough, otherwise insert a new
+       one before it */
+    c = a->current ? a->current->next : a->first;
+    if (!c || c->size < size + align - 1) {
+        size_t s = size + align - 1;
+        SCE_SArenaChunk *new = NULL;
+        if (!(new = SCE_Arena_CreateChunk (s > a->chunk_size ?
+                                           s : a->chunk_size))) {
+            SCEE_LogSrc ();
+            return NULL;
+        }
+        new->next = c;
+        if (a->current)
+            a->current->next = new;
+        else
+            a->first = new;
+        c = new;
+    }
+    c->used = 0;
+    a->current = c;
+    return SCE_Arena_AllocInChunk (c, align, size);
+}
+/**
+ * \brief Allocates memory from an arena
+ * \param a an arena
+ * \param size size of the block, in bytes
+ * \returns the new block aligned on SCE_ARENA_ALIGN, or NULL on error
+ * \see SCE_Arena_AllocAligned()
+ */
+void* SCE_Arena_Alloc (SCE_SArena *a, size_t size)
+{
+    return SCE_Arena_AllocAligned (a, SCE_ARENA_ALIGN, size);
+}
+/**
+ * \brief Copies memory into an arena
+ * \param a an arena
+ * \param p the memory to duplicate
+ * \param size size of \p p, in bytes
+ * \returns the copy, or NULL on error
+ */
+void* SCE_Arena_Dup (SCE_SArena *a, const void *p, size_t size)
+{
+    void *new = SCE_Arena_Alloc (a, size);
+    if (new)
+        memcpy (new, p, size);
+    else
+        SCEE_LogSrc ();
+    return new;
+}
+
+
+/**
+ * \brief Gets the current position of an arena
+ * \param a an arena
+ * \param mark where to store the position
+ * \see SCE_Arena_PopMark()
+ */
+void SCE_Arena_GetMark (const SCE_SArena *a, SCE_SArenaMark *mark)
+{
+    mark->chunk = a->current;
+    mark->used = a->current ? a->current->used : 0;
+}
+/**
+ * \brief Frees everything allocated in an arena since a mark was taken
+ * \param a an arena
+ * \param mark a mark given by SCE_Arena_GetMark() on \p a
+ *
+ * Marks taken after \p mark are invalidated.
+ */
+void SCE_Arena_PopMark (SCE_SArena *a, const SCE_SArenaMark *mark)
+{
+    if (mark->chunk) {
+        a->current = mark->chunk;
+        a->current->used = mark->used;
+    } else if ((a->current = a->first))
+        a->current->used = 0;
+}
+/**
+ * \brief Frees everything allocated in an arena
+ * \param a an arena
+ *
+ * The chunks are kept for the next allocations, this function runs in
+ * constant time.
+ */
+void SCE_Arena_Reset (SCE_SArena *a)
+{
+    if ((a->current = a->first))
+        a->current->used = 0;
+    a->n_resets++;
+}
+
+/**
+ * \brief Gets the number of bytes in use in an arena, padding included
+ */
+size_t SCE_Arena_GetUsed (const SCE_SArena *a)
+{
+    size_t used = 0;
+    SCE_SArenaChunk *c = NULL;
+    if (a->current) {
+        for (c = a->first; c != a->current; c = c->next)
+            used += c->used;
+        used += c->used;
+    }
+    return used;
+}
+
+
+/**
+ * \brief Gets the arena of the calling thread
+ * \returns the arena of the calling thread, or NULL on error
+ *
+ * The arena is created on the first call and deleted when the thread exits.
+ * It is up to the caller to reset it, usually once per frame.
+ */
+SCE_SArena* SCE_Arena_GetThreadArena (void)
+{
+    if (!thread_arena) {
+        pthread_once (&arena_once, SCE_Arena_InitOnce);
+        if (!(thread_arena = SCE_Arena_Create ()))
+            SCEE_LogSrc ();
+        else
+            pthread_setspecific (arena_key, thread_arena);
+    }
+    return thread_arena;
+}
+
+
+#ifdef SCE_DEBUG
+/**
+ * \brief Lists the arenas holding memory that were never reset
+ */
+void SCE_Arena_List (void)
+{
+    unsigned int n = 0;
+    SCE_SListIterator *it = NULL;
+
+    pthread_once (&arena_once, SCE_Arena_InitOnce);
+    pthread_mutex_lock (&arenas_m);
+    SCE_List_ForEach (it, &arenas) {
+        SCE_SArena *a = SCE_List_GetData (it);
+        if (!a->n_resets && a->first) {
+            unsigned int n_chunks = 0;
+            SCE_SArenaChunk *c = NULL;
+            for (c = a->first; c; c = c->next)
+                n_chunks++;
+            SCEE_SendMsg ("- arena %p: %zu bytes in %u chunks.\n",
+                          (void*)a, SCE_Arena_GetUsed (a), n_chunks);
+            n++;
+        }
+    }
+    pthread_mutex_unlock (&arenas_m);
+    SCEE_SendMsg ("you have %u arenas never reset.\n", n);
+}
+#endif
+
+/** @} */
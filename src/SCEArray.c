@@ -17,9 +17,10 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/05/2012
-   updated: 17/05/2012 */
+   updated: 18/10/2026 */
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
@@ -30,33 +31,329 @@ void SCE_Array_Init (SCE_SArray *a)
     a->ptr = NULL;
     a->size = 0;
     a->allocated = 0;
+    a->align = 0;
+    a->growth = SCE_ARRAY_DEFAULT_GROWTH * 256;
+    a->inline_ptr = NULL;
+    a->inline_size = 0;
+    SCE_Mem_InitRegion (&a->region);
+}
+/**
+ * \brief Initializes an array storing its first bytes in a given buffer
+ * \param a an array
+ * \param buf storage of \p a until it holds more than \p size bytes
+ * \param size size of \p buf in bytes
+ *
+ * \p a allocates nothing until it outgrows \p buf, its data is then moved
+ * to the heap. \p buf must live as long as \p a, which is best achieved
+ * with SCE_SMALLARRAY() for short-lived arrays on the stack or arrays
+ * embedded in other structures.
+ * \sa SCE_SmallArray_Init(), SCE_Array_IsInline()
+ */
+void SCE_Array_InitInline (SCE_SArray *a, void *buf, size_t size)
+{
+    SCE_Array_Init (a);
+    a->inline_ptr = buf;
+    a->inline_size = size;
+    a->ptr = buf;
+    a->allocated = size;
 }
 void SCE_Array_Clear (SCE_SArray *a)
 {
-    SCE_free (a->ptr);
+    if (a->region.base)
+        SCE_Mem_ClearRegion (&a->region);
+    else if (a->ptr != a->inline_ptr)
+        SCE_free (a->ptr);
 }
 
-int SCE_Array_Append (SCE_SArray *a, void *data, size_t size)
+/**
+ * \brief Sets the alignment of the data of an array
+ * \param a an array
+ * \param align alignment in bytes, must be a power of two, 0 restores the
+ * default alignment of SCE_malloc()
+ *
+ * Call this before appending anything to \p a, useful to store SIMD
+ * vectors or cache line aligned records. Inline storage not matching
+ * \p align is dropped.
+ */
+void SCE_Array_SetAlignment (SCE_SArray *a, size_t align)
+{
+    a->align = align;
+    if (align && a->inline_ptr && ((size_t)a->inline_ptr & (align - 1))) {
+        if (a->ptr == a->inline_ptr) {
+            a->ptr = NULL;
+            a->allocated = 0;
+        }
+        a->inline_ptr = NULL;
+        a->inline_size = 0;
+    }
+}
+
+/**
+ * \brief Bounds the size of an array, for very big arrays
+ * \param a an array
+ * \param max maximum size in bytes \p a will ever reach
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * When \p max is at least SCE_ARRAY_REGION_SIZE, the data of \p a is stored
+ * in a SCE_SMemRegion reserving \p max bytes of address space: growing the
+ * array then never moves nor copies its data, and pointers into it stay
+ * valid. Appending past \p max fails. Smaller values of \p max are
+ * ignored. Can be called at any time, the data of \p a is kept.
+ * \sa SCE_Mem_ReserveRegion()
+ */
+int SCE_Array_SetMaxSize (SCE_SArray *a, size_t max)
+{
+    SCE_SMemRegion region;
+
+    if (max < SCE_ARRAY_REGION_SIZE || a->region.base)
+        return SCE_OK;
+    SCE_Mem_InitRegion (&region);
+    if (SCE_Mem_ReserveRegion (&region, max) < 0 ||
+        SCE_Mem_CommitRegion (&region, a->size) < 0) {
+        SCE_Mem_ClearRegion (&region);
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    if (a->ptr) {
+        memcpy (region.base, a->ptr, a->size);
+        if (a->ptr != a->inline_ptr)
+            SCE_free (a->ptr);
+    }
+    a->region = region;
+    a->ptr = region.base;
+    a->allocated = region.committed;
+    return SCE_OK;
+}
+
+/**
+ * \brief Sets how much an array grows when it is full
+ * \param a an array
+ * \param growth factor applied to the allocated size of \p a, from 1.1 to
+ * 16
+ *
+ * The default is SCE_ARRAY_DEFAULT_GROWTH. Lower values waste less memory
+ * but make more reallocations. Arrays stored in a region (see
+ * SCE_Array_SetMaxSize()) ignore it.
+ */
+void SCE_Array_SetGrowth (SCE_SArray *a, float growth)
+{
+    if (growth < 1.1f)
+        growth = 1.1f;
+    else if (growth > 16.0f)
+        growth = 16.0f;
+    a->growth = growth * 256;
+}
+
+/* sets the allocated size of \p a to \p size bytes, at least a->size */
+static int SCE_Array_Realloc (SCE_SArray *a, size_t size)
+{
+    unsigned char *ptr = NULL, *old = a->ptr;
+
+    if (a->region.base) {
+        /* fails past the reserved size */
+        if (SCE_Mem_CommitRegion (&a->region, size) < 0)
+            goto fail;
+        a->allocated = a->region.committed;
+        return SCE_OK;
+    }
+    if (old == a->inline_ptr)
+        old = NULL;
+    if (a->align)
+        ptr = SCE_realloc_aligned (old, a->align, size);
+    else
+        ptr = SCE_realloc (old, size);
+    if (!ptr)
+        goto fail;
+    if (!old && a->ptr)
+        memcpy (ptr, a->ptr, a->size);
+    a->ptr = ptr;
+    a->allocated = size;
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+/* makes room for \p size bytes, applying the growth factor */
+static int SCE_Array_Grow (SCE_SArray *a, size_t size)
+{
+    size_t allocated = size, extra = 0, factor = a->growth - 256;
+
+    if (size <= a->allocated)
+        return SCE_OK;
+    /* regions commit pages on demand, growing them faster than needed
+       would only fail sooner */
+    if (!a->region.base) {
+        /* divide last to keep the growth of small arrays */
+        if (a->allocated <= SIZE_MAX / factor)
+            extra = a->allocated * factor / 256;
+        else if (a->allocated / 256 <= SIZE_MAX / factor)
+            extra = a->allocated / 256 * factor;
+        if (extra && a->allocated <= SIZE_MAX - extra &&
+            a->allocated + extra > allocated)
+            allocated = a->allocated + extra;
+    }
+    if (allocated < SCE_ARRAY_MIN_SIZE)
+        allocated = SCE_ARRAY_MIN_SIZE;
+    if (SCE_Array_Realloc (a, allocated) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Allocates memory for an array in advance
+ * \param a an array
+ * \param size number of bytes \p a should be able to hold without
+ * reallocating
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_Array_Reserve (SCE_SArray *a, size_t size)
+{
+    if (size > a->allocated && SCE_Array_Realloc (a, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Adds bytes at the end of an array without writing them
+ * \param a an array
+ * \param size number of bytes to add
+ * \returns a pointer to the \p size new bytes, to be written by the caller,
+ * or NULL on error
+ *
+ * The returned pointer is valid until the next call growing \p a.
+ * \sa SCE_Array_Append(), SCE_Array_EmplaceN()
+ */
+void* SCE_Array_Emplace (SCE_SArray *a, size_t size)
 {
-    size_t offset;
+    size_t offset = a->size;
 
-    offset = a->size;
+    if (size > SIZE_MAX - offset) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        SCEE_LogMsg ("array size overflow");
+        return NULL;
+    }
+    if (SCE_Array_Grow (a, offset + size) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
     a->size += size;
-    if (a->size > a->allocated) {
-        if (a->allocated == 0)
-            a->allocated = 1;
-        do
-            a->allocated *= 2;
-        while (a->size > a->allocated);
-        if (!(a->ptr = SCE_realloc (a->ptr, a->allocated))) {
-            SCEE_LogSrc ();
-            return SCE_ERROR;
-        }
+    return &a->ptr[offset];
+}
+
+/**
+ * \brief Copies bytes at the end of an array
+ * \param a an array
+ * \param data the bytes to copy
+ * \param size number of bytes in \p data
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ * \sa SCE_Array_Emplace()
+ */
+int SCE_Array_Append (SCE_SArray *a, void *data, size_t size)
+{
+    void *dst = NULL;
+
+    if (!(dst = SCE_Array_Emplace (a, size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (dst, data, size);
+    return SCE_OK;
+}
+
+/**
+ * \brief Removes bytes from the end of an array
+ * \param a an array
+ * \param data where to copy the removed bytes, can be NULL
+ * \param size number of bytes to remove
+ * \returns SCE_OK, or SCE_ERROR if \p a holds less than \p size bytes
+ */
+int SCE_Array_Pop (SCE_SArray *a, void *data, size_t size)
+{
+    if (size > a->size) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("cannot pop %lu bytes from an array of %lu bytes",
+                     (unsigned long)size, (unsigned long)a->size);
+        return SCE_ERROR;
     }
-    memcpy (&a->ptr[offset], data, size);
+    a->size -= size;
+    if (data)
+        memcpy (data, &a->ptr[a->size], size);
     return SCE_OK;
 }
 
+/**
+ * \brief Sets the size of an array
+ * \param a an array
+ * \param size new size in bytes, new bytes are not initialized
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ * \sa SCE_Array_Truncate()
+ */
+int SCE_Array_Resize (SCE_SArray *a, size_t size)
+{
+    if (SCE_Array_Grow (a, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    a->size = size;
+    return SCE_OK;
+}
+/**
+ * \brief Shortens an array, keeps its memory
+ * \param a an array
+ * \param size new size in bytes, nothing is done if it is not lower than
+ * the current size
+ */
+void SCE_Array_Truncate (SCE_SArray *a, size_t size)
+{
+    if (size < a->size)
+        a->size = size;
+}
+/**
+ * \brief Frees the memory allocated past the size of an array
+ * \param a an array
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * Does nothing for arrays stored in a region. Arrays fitting back in
+ * their inline storage (see SCE_Array_InitInline()) move back to it.
+ */
+int SCE_Array_ShrinkToFit (SCE_SArray *a)
+{
+    if (a->region.base || a->size == a->allocated ||
+        a->ptr == a->inline_ptr)
+        return SCE_OK;
+    if (a->inline_ptr && a->size <= a->inline_size) {
+        memcpy (a->inline_ptr, a->ptr, a->size);
+        SCE_free (a->ptr);
+        a->ptr = a->inline_ptr;
+        a->allocated = a->inline_size;
+        return SCE_OK;
+    }
+    if (!a->size) {
+        SCE_free (a->ptr);
+        a->ptr = NULL;
+        a->allocated = 0;
+        return SCE_OK;
+    }
+    if (SCE_Array_Realloc (a, a->size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Tells whether the data of an array is in its inline storage
+ * \sa SCE_Array_InitInline()
+ */
+int SCE_Array_IsInline (const SCE_SArray *a)
+{
+    return a->ptr && a->ptr == a->inline_ptr;
+}
+
 void* SCE_Array_Get (const SCE_SArray *a)
 {
     return a->ptr;
@@ -66,3 +363,10 @@ size_t SCE_Array_GetSize (const SCE_SArray *a)
 {
     return a->size;
 }
+/**
+ * \brief Gets the number of bytes an array can hold without reallocating
+ */
+size_t SCE_Array_GetCapacity (const SCE_SArray *a)
+{
+    return a->allocated;
+}
@@ -0,0 +1,342 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEWorkers.h"
+#include "SCE/utils/SCEChunkArray.h"
+
+/**
+ * \file SCEChunkArray.c
+ * \copydoc chunkarray
+ * \brief Segmented arrays with stable addresses
+ *
+ * \file SCEChunkArray.h
+ * \copydoc chunkarray
+ * \brief Segmented arrays with stable addresses
+ */
+
+/**
+ * \defgroup chunkarray Segmented arrays with stable addresses
+ * \ingroup utils
+ * \brief Growable arrays whose elements keep their address
+ *
+ * A SCE_SChunkArray stores its elements in segments of a power of two
+ * number of elements. Growing the array allocates new segments and never
+ * moves the existing ones, so pointers to elements stay valid until they
+ * are removed, and nothing is copied. Element \c i lives in segment
+ * <tt>i >> shift</tt> at offset <tt>i & mask</tt>, which
+ * SCE_ChunkArray_Get() computes in constant time.
+ *
+ * Segments are contiguous, SCE_ChunkArray_ForEach() and
+ * SCE_ChunkArray_ParallelForEach() hand them whole to a callback, the
+ * latter spreading them over the worker threads. This suits pools of
+ * particles, entities or vertices growing over time.
+ */
+
+/** @{ */
+
+/* minimum number of segment pointers allocated at once */
+#define SCE_CHUNKARRAY_MIN_SEGMENTS 8
+
+/**
+ * \brief Initializes a chunked array
+ * \param a the array to initialize
+ * \param elem_size size of one element in bytes
+ * \param shift base 2 logarithm of the number of elements of a segment,
+ * 0 for SCE_CHUNKARRAY_DEFAULT_SHIFT, at most SCE_CHUNKARRAY_MAX_SHIFT
+ */
+void SCE_ChunkArray_Init (SCE_SChunkArray *a, size_t elem_size,
+                          unsigned int shift)
+{
+    if (!shift)
+        shift = SCE_CHUNKARRAY_DEFAULT_SHIFT;
+    else if (shift > SCE_CHUNKARRAY_MAX_SHIFT)
+        shift = SCE_CHUNKARRAY_MAX_SHIFT;
+    a->segments = NULL;
+    a->n_segments = a->max_segments = 0;
+    a->size = 0;
+    a->elem_size = elem_size;
+    a->shift = shift;
+    a->mask = ((size_t)1 << shift) - 1;
+}
+/**
+ * \brief Clears a chunked array, frees all its segments
+ * \param a the array to clear
+ */
+void SCE_ChunkArray_Clear (SCE_SChunkArray *a)
+{
+    size_t i;
+    for (i = 0; i < a->n_segments; i++)
+        SCE_free (a->segments[i]);
+    SCE_free (a->segments);
+    a->segments = NULL;
+    a->n_segments = a->max_segments = 0;
+    a->size = 0;
+}
+/**
+ * \brief Creates a chunked array
+ * \sa SCE_ChunkArray_Init()
+ */
+SCE_SChunkArray* SCE_ChunkArray_Create (size_t elem_size, unsigned int shift)
+{
+    SCE_SChunkArray *a = NULL;
+    if (!(a = SCE_malloc (sizeof *a)))
+        SCEE_LogSrc ();
+    else
+        SCE_ChunkArray_Init (a, elem_size, shift);
+    return a;
+}
+/**
+ * \brief Deletes a chunked array created by SCE_ChunkArray_Create()
+ */
+void SCE_ChunkArray_Delete (SCE_SChunkArray *a)
+{
+    if (a) {
+        SCE_ChunkArray_Clear (a);
+        SCE_free (a);
+    }
+}
+
+/* allocates one more segment */
+static int SCE_ChunkArray_AddSegment (SCE_SChunkArray *a)
+{
+    unsigned char *seg = NULL;
+
+    if (a->n_segments == a->max_segments) {
+        unsigned char **segments = NULL;
+        size_t max = a->max_segments * 2;
+        if (max < SCE_CHUNKARRAY_MIN_SEGMENTS)
+            max = SCE_CHUNKARRAY_MIN_SEGMENTS;
+        if (!(segments = SCE_realloc (a->segments, max * sizeof *segments)))
+            goto fail;
+        a->segments = segments;
+        a->max_segments = max;
+    }
+    if (!(seg = SCE_malloc (a->elem_size << a->shift)))
+        goto fail;
+    a->segments[a->n_segments++] = seg;
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+
+/**
+ * \brief Allocates the segments to hold a number of elements
+ * \param a a chunked array
+ * \param n number of elements \p a should hold without allocating
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_ChunkArray_Reserve (SCE_SChunkArray *a, size_t n)
+{
+    size_t needed = (n + a->mask) >> a->shift;
+
+    while (a->n_segments < needed) {
+        if (SCE_ChunkArray_AddSegment (a) < 0) {
+            SCEE_LogSrc ();
+            return SCE_ERROR;
+        }
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Removes all the elements of a chunked array, keeps its segments
+ */
+void SCE_ChunkArray_Flush (SCE_SChunkArray *a)
+{
+    a->size = 0;
+}
+
+/**
+ * \brief Adds an element at the end of a chunked array without writing it
+ * \param a a chunked array
+ * \returns a pointer to the new element, to be written by the caller, or
+ * NULL on error
+ *
+ * The returned pointer stays valid until the element is removed.
+ */
+void* SCE_ChunkArray_Emplace (SCE_SChunkArray *a)
+{
+    size_t i = a->size;
+
+    if ((i >> a->shift) == a->n_segments &&
+        SCE_ChunkArray_AddSegment (a) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    a->size++;
+    return SCE_ChunkArray_Get (a, i);
+}
+/**
+ * \brief Copies an element at the end of a chunked array
+ * \param a a chunked array
+ * \param elem the element, \c elem_size bytes are copied
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_ChunkArray_Push (SCE_SChunkArray *a, const void *elem)
+{
+    void *dst = NULL;
+
+    if (!(dst = SCE_ChunkArray_Emplace (a))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (dst, elem, a->elem_size);
+    return SCE_OK;
+}
+/**
+ * \brief Removes the last element of a chunked array
+ * \param a a chunked array
+ * \param elem where to copy the removed element, can be NULL
+ * \returns SCE_OK, or SCE_ERROR if \p a is empty
+ */
+int SCE_ChunkArray_Pop (SCE_SChunkArray *a, void *elem)
+{
+    if (!a->size)
+        return SCE_ERROR;
+    a->size--;
+    if (elem)
+        memcpy (elem, SCE_ChunkArray_Get (a, a->size), a->elem_size);
+    return SCE_OK;
+}
+/**
+ * \brief Removes an element by moving the last one in its place
+ * \param a a chunked array
+ * \param i index of the element to remove
+ *
+ * Only the address of the last element changes, it becomes \p i.
+ */
+void SCE_ChunkArray_SwapRemove (SCE_SChunkArray *a, size_t i)
+{
+    a->size--;
+    if (i != a->size)
+        memcpy (SCE_ChunkArray_Get (a, i), SCE_ChunkArray_Get (a, a->size),
+                a->elem_size);
+}
+size_t SCE_ChunkArray_GetSize (const SCE_SChunkArray *a)
+{
+    return a->size;
+}
+
+/**
+ * \brief Gets the number of segments holding elements
+ */
+size_t SCE_ChunkArray_GetNumSegments (const SCE_SChunkArray *a)
+{
+    return (a->size + a->mask) >> a->shift;
+}
+/**
+ * \brief Gets the elements of a segment
+ * \param a a chunked array
+ * \param seg index of the segment, lower than
+ * SCE_ChunkArray_GetNumSegments()
+ * \param n returns the number of elements of the segment, can be NULL
+ * \returns the first element of the segment, the others follow it
+ */
+void* SCE_ChunkArray_GetSegment (const SCE_SChunkArray *a, size_t seg,
+                                 size_t *n)
+{
+    if (n) {
+        size_t first = seg << a->shift;
+        *n = a->size - first > a->mask ? a->mask + 1 : a->size - first;
+    }
+    return a->segments[seg];
+}
+
+/**
+ * \brief Calls a function on each segment of a chunked array
+ * \param a a chunked array
+ * \param f function called once per segment holding elements
+ * \param param user data given to \p f
+ */
+void SCE_ChunkArray_ForEach (SCE_SChunkArray *a, SCE_FChunkArrayFunc f,
+                             void *param)
+{
+    size_t i, n_segments = SCE_ChunkArray_GetNumSegments (a);
+
+    for (i = 0; i < n_segments; i++) {
+        size_t n;
+        void *elems = SCE_ChunkArray_GetSegment (a, i, &n);
+        f (elems, i << a->shift, n, param);
+    }
+}
+
+typedef struct sce_schunkarrayparallel SCE_SChunkArrayParallel;
+struct sce_schunkarrayparallel {
+    SCE_SChunkArray *a;
+    SCE_FChunkArrayFunc f;
+    void *param;
+    size_t per_task;            /* segments per task */
+};
+
+static void SCE_ChunkArray_ParallelTask (unsigned int task, void *data)
+{
+    SCE_SChunkArrayParallel *p = data;
+    size_t i, end, n_segments = SCE_ChunkArray_GetNumSegments (p->a);
+
+    i = task * p->per_task;
+    end = i + p->per_task < n_segments ? i + p->per_task : n_segments;
+    for (; i < end; i++) {
+        size_t n;
+        void *elems = SCE_ChunkArray_GetSegment (p->a, i, &n);
+        p->f (elems, i << p->a->shift, n, p->param);
+    }
+}
+
+/**
+ * \brief Calls a function on each segment of a chunked array from the
+ * worker threads
+ * \param a a chunked array
+ * \param f function called once per segment holding elements, must be
+ * thread safe
+ * \param param user data given to \p f
+ *
+ * Segments are distributed to at most SCE_Workers_GetCount() tasks of
+ * consecutive segments. \p a must not be modified until this function
+ * returns.
+ * \sa SCE_ChunkArray_ForEach(), SCE_Workers_Run()
+ */
+void SCE_ChunkArray_ParallelForEach (SCE_SChunkArray *a,
+                                     SCE_FChunkArrayFunc f, void *param)
+{
+    SCE_SChunkArrayParallel p;
+    size_t n_segments = SCE_ChunkArray_GetNumSegments (a);
+    size_t n_tasks = SCE_Workers_GetCount ();
+
+    if (n_tasks > n_segments)
+        n_tasks = n_segments;
+    if (n_tasks < 2) {
+        SCE_ChunkArray_ForEach (a, f, param);
+        return;
+    }
+    p.a = a;
+    p.f = f;
+    p.param = param;
+    p.per_task = (n_segments + n_tasks - 1) / n_tasks;
+    n_tasks = (n_segments + p.per_task - 1) / p.per_task;
+    SCE_Workers_Run (n_tasks, SCE_ChunkArray_ParallelTask, &p);
+}
+
+/** @} */
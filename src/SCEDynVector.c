@@ -0,0 +1,478 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEDynVector.h"
+
+/**
+ * \file SCEDynVector.c
+ * \copydoc dynvector
+ * \brief Contiguous growable arrays
+ *
+ * \file SCEDynVector.h
+ * \copydoc dynvector
+ * \brief Contiguous growable arrays
+ */
+
+/**
+ * \defgroup dynvector Contiguous growable arrays
+ * \ingroup utils
+ * \brief Containers storing their elements next to each other
+ *
+ * SCE_SVector stores pointers and SCE_SValueVector stores elements of any
+ * given size by value. Walking them touches consecutive memory instead of
+ * following the scattered nodes of a SCE_SList, and adding an element costs
+ * no allocation most of the time. The ForEach macros mirror those of
+ * SCEList so that collections can move from one to the other easily.
+ */
+
+/** @{ */
+
+/* minimum number of elements allocated at once */
+#define SCE_VECTOR_MIN_CAPACITY 8
+
+/* makes room for \p n elements of \p elem_size bytes in \p data */
+static int SCE_Vector_Grow (void *data, size_t *capacity, size_t elem_size,
+                            size_t n)
+{
+    void *new = NULL;
+    size_t cap = *capacity;
+
+    if (n <= cap)
+        return SCE_OK;
+    if (cap < SCE_VECTOR_MIN_CAPACITY)
+        cap = SCE_VECTOR_MIN_CAPACITY;
+    while (cap < n)
+        cap *= 2;
+    if (!(new = SCE_realloc (*(void**)data, cap * elem_size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    *(void**)data = new;
+    *capacity = cap;
+    return SCE_OK;
+}
+
+/* stable merge sort of \p n elements, \p deref tells whether the elements
+   are pointers to the data to give to \p func */
+static void SCE_Vector_MergeSort (unsigned char *data, unsigned char *tmp,
+                                  size_t n, size_t elem_size, int deref,
+                                  SCE_FListCompareData func)
+{
+    size_t half = n / 2, i = 0, j = half, k = 0;
+
+    if (n < 2)
+        return;
+    SCE_Vector_MergeSort (data, tmp, half, elem_size, deref, func);
+    SCE_Vector_MergeSort (data + half * elem_size, tmp, n - half, elem_size,
+                          deref, func);
+    memcpy (tmp, data, n * elem_size);
+    while (i < half && j < n) {
+        unsigned char *a = &tmp[i * elem_size], *b = &tmp[j * elem_size];
+        int c = deref ? func (*(void**)a, *(void**)b) : func (a, b);
+        if (c <= 0) {
+            memcpy (&data[k * elem_size], a, elem_size);
+            i++;
+        } else {
+            memcpy (&data[k * elem_size], b, elem_size);
+            j++;
+        }
+        k++;
+    }
+    if (i < half)
+        memcpy (&data[k * elem_size], &tmp[i * elem_size],
+                (half - i) * elem_size);
+    /* elements left from the second half are already in place */
+}
+
+static int SCE_Vector_SortData (unsigned char *data, size_t n,
+                                size_t elem_size, int deref,
+                                SCE_FListCompareData func)
+{
+    unsigned char *tmp = NULL;
+    if (n < 2)
+        return SCE_OK;
+    if (!(tmp = SCE_malloc (n * elem_size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    SCE_Vector_MergeSort (data, tmp, n, elem_size, deref, func);
+    SCE_free (tmp);
+    return SCE_OK;
+}
+
+
+/**
+ * \brief Initializes a vector
+ * \param v the vector to initialize
+ */
+void SCE_Vector_Init (SCE_SVector *v)
+{
+    v->data = NULL;
+    v->size = v->capacity = 0;
+}
+/**
+ * \brief Clears a vector, frees its memory but not its elements
+ * \param v the vector to clear
+ */
+void SCE_Vector_Clear (SCE_SVector *v)
+{
+    SCE_free (v->data);
+    SCE_Vector_Init (v);
+}
+/**
+ * \brief Creates a new vector
+ * \returns a newly allocated vector, or NULL on error
+ */
+SCE_SVector* SCE_Vector_Create (void)
+{
+    SCE_SVector *v = NULL;
+    if (!(v = SCE_malloc (sizeof *v)))
+        SCEE_LogSrc ();
+    else
+        SCE_Vector_Init (v);
+    return v;
+}
+/**
+ * \brief Deletes a vector
+ * \param v the vector to delete
+ */
+void SCE_Vector_Delete (SCE_SVector *v)
+{
+    if (v) {
+        SCE_Vector_Clear (v);
+        SCE_free (v);
+    }
+}
+
+/**
+ * \brief Makes room for a number of elements
+ * \param v a vector
+ * \param n number of elements \p v should be able to hold
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_Vector_Reserve (SCE_SVector *v, size_t n)
+{
+    if (SCE_Vector_Grow (&v->data, &v->capacity, sizeof *v->data, n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Removes all the elements of a vector, keeps its memory
+ */
+void SCE_Vector_Flush (SCE_SVector *v)
+{
+    v->size = 0;
+}
+/**
+ * \brief Adds an element at the end of a vector
+ * \param v a vector
+ * \param p the element to add
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_Vector_Push (SCE_SVector *v, void *p)
+{
+    if (v->size == v->capacity && SCE_Vector_Reserve (v, v->size + 1) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    v->data[v->size++] = p;
+    return SCE_OK;
+}
+/**
+ * \brief Removes the last element of a vector
+ * \param v a vector
+ * \returns the removed element, NULL if \p v is empty
+ */
+void* SCE_Vector_Pop (SCE_SVector *v)
+{
+    if (!v->size)
+        return NULL;
+    return v->data[--v->size];
+}
+/**
+ * \brief Inserts an element in a vector
+ * \param v a vector
+ * \param i index of the new element, up to SCE_Vector_GetSize()
+ * \param p the element to insert
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The elements from \p i are shifted by one, this is O(n).
+ */
+int SCE_Vector_Insert (SCE_SVector *v, size_t i, void *p)
+{
+    if (v->size == v->capacity && SCE_Vector_Reserve (v, v->size + 1) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memmove (&v->data[i + 1], &v->data[i], (v->size - i) * sizeof *v->data);
+    v->data[i] = p;
+    v->size++;
+    return SCE_OK;
+}
+/**
+ * \brief Removes an element of a vector, keeping the order of the others
+ * \param v a vector
+ * \param i index of the element to remove
+ * \returns the removed element
+ *
+ * This is O(n), use SCE_Vector_SwapRemove() when the order does not matter.
+ */
+void* SCE_Vector_Remove (SCE_SVector *v, size_t i)
+{
+    void *p = v->data[i];
+    v->size--;
+    memmove (&v->data[i], &v->data[i + 1], (v->size - i) * sizeof *v->data);
+    return p;
+}
+/**
+ * \brief Removes an element of a vector in O(1)
+ * \param v a vector
+ * \param i index of the element to remove
+ * \returns the removed element
+ *
+ * The last element of \p v takes the place of the removed one.
+ */
+void* SCE_Vector_SwapRemove (SCE_SVector *v, size_t i)
+{
+    void *p = v->data[i];
+    v->data[i] = v->data[--v->size];
+    return p;
+}
+/**
+ * \brief Gets the index of an element
+ * \param v a vector
+ * \param p the element to look for
+ * \returns the index of the first occurrence of \p p, or
+ * SCE_VECTOR_NOT_FOUND
+ */
+size_t SCE_Vector_Locate (const SCE_SVector *v, const void *p)
+{
+    size_t i;
+    for (i = 0; i < v->size; i++) {
+        if (v->data[i] == p)
+            return i;
+    }
+    return SCE_VECTOR_NOT_FOUND;
+}
+/**
+ * \brief Sorts a vector
+ * \param v a vector
+ * \param func compares two elements, like for SCE_List_Sort()
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The sort is stable.
+ */
+int SCE_Vector_Sort (SCE_SVector *v, SCE_FListCompareData func)
+{
+    if (SCE_Vector_SortData ((unsigned char*)v->data, v->size,
+                             sizeof *v->data, SCE_TRUE, func) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gets the number of elements of a vector
+ */
+size_t SCE_Vector_GetSize (const SCE_SVector *v)
+{
+    return v->size;
+}
+
+
+/**
+ * \brief Initializes a value vector
+ * \param v the vector to initialize
+ * \param elem_size size of the elements of \p v
+ */
+void SCE_ValueVector_Init (SCE_SValueVector *v, size_t elem_size)
+{
+    v->data = NULL;
+    v->size = v->capacity = 0;
+    v->elem_size = elem_size;
+}
+/**
+ * \brief Clears a value vector
+ * \param v the vector to clear
+ */
+void SCE_ValueVector_Clear (SCE_SValueVector *v)
+{
+    SCE_free (v->data);
+    SCE_ValueVector_Init (v, v->elem_size);
+}
+/**
+ * \brief Creates a new value vector
+ * \param elem_size size of the elements of the vector
+ * \returns a newly allocated vector, or NULL on error
+ */
+SCE_SValueVector* SCE_ValueVector_Create (size_t elem_size)
+{
+    SCE_SValueVector *v = NULL;
+    if (!(v = SCE_malloc (sizeof *v)))
+        SCEE_LogSrc ();
+    else
+        SCE_ValueVector_Init (v, elem_size);
+    return v;
+}
+/**
+ * \brief Deletes a value vector
+ * \param v the vector to delete
+ */
+void SCE_ValueVector_Delete (SCE_SValueVector *v)
+{
+    if (v) {
+        SCE_ValueVector_Clear (v);
+        SCE_free (v);
+    }
+}
+
+/**
+ * \brief Makes room for a number of elements
+ * \param v a value vector
+ * \param n number of elements \p v should be able to hold
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_ValueVector_Reserve (SCE_SValueVector *v, size_t n)
+{
+    if (SCE_Vector_Grow (&v->data, &v->capacity, v->elem_size, n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Removes all the elements of a value vector, keeps its memory
+ */
+void SCE_ValueVector_Flush (SCE_SValueVector *v)
+{
+    v->size = 0;
+}
+/**
+ * \brief Copies an element at the end of a value vector
+ * \param v a value vector
+ * \param elem the element to copy
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_ValueVector_Push (SCE_SValueVector *v, const void *elem)
+{
+    if (v->size == v->capacity &&
+        SCE_ValueVector_Reserve (v, v->size + 1) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (SCE_ValueVector_Get (v, v->size), elem, v->elem_size);
+    v->size++;
+    return SCE_OK;
+}
+/**
+ * \brief Removes the last element of a value vector
+ * \param v a value vector
+ * \param elem where to copy the removed element, can be NULL
+ * \returns SCE_OK, or SCE_ERROR if \p v is empty
+ */
+int SCE_ValueVector_Pop (SCE_SValueVector *v, void *elem)
+{
+    if (!v->size)
+        return SCE_ERROR;
+    v->size--;
+    if (elem)
+        memcpy (elem, SCE_ValueVector_Get (v, v->size), v->elem_size);
+    return SCE_OK;
+}
+/**
+ * \brief Inserts an element in a value vector
+ * \param v a value vector
+ * \param i index of the new element, up to SCE_ValueVector_GetSize()
+ * \param elem the element to copy
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_ValueVector_Insert (SCE_SValueVector *v, size_t i, const void *elem)
+{
+    if (v->size == v->capacity &&
+        SCE_ValueVector_Reserve (v, v->size + 1) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memmove (SCE_ValueVector_Get (v, i + 1), SCE_ValueVector_Get (v, i),
+             (v->size - i) * v->elem_size);
+    memcpy (SCE_ValueVector_Get (v, i), elem, v->elem_size);
+    v->size++;
+    return SCE_OK;
+}
+/**
+ * \brief Removes an element of a value vector, keeping the order of the
+ * others
+ * \param v a value vector
+ * \param i index of the element to remove
+ */
+void SCE_ValueVector_Remove (SCE_SValueVector *v, size_t i)
+{
+    v->size--;
+    memmove (SCE_ValueVector_Get (v, i), SCE_ValueVector_Get (v, i + 1),
+             (v->size - i) * v->elem_size);
+}
+/**
+ * \brief Removes an element of a value vector in O(1)
+ * \param v a value vector
+ * \param i index of the element to remove
+ *
+ * The last element of \p v takes the place of the removed one.
+ */
+void SCE_ValueVector_SwapRemove (SCE_SValueVector *v, size_t i)
+{
+    v->size--;
+    if (i != v->size)
+        memcpy (SCE_ValueVector_Get (v, i), SCE_ValueVector_Get (v, v->size),
+                v->elem_size);
+}
+/**
+ * \brief Sorts a value vector
+ * \param v a value vector
+ * \param func compares two elements, it is given pointers to the elements
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The sort is stable.
+ */
+int SCE_ValueVector_Sort (SCE_SValueVector *v, SCE_FListCompareData func)
+{
+    if (SCE_Vector_SortData (v->data, v->size, v->elem_size, SCE_FALSE,
+                             func) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gets the number of elements of a value vector
+ */
+size_t SCE_ValueVector_GetSize (const SCE_SValueVector *v)
+{
+    return v->size;
+}
+
+/** @} */
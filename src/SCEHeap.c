@@ -0,0 +1,322 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEHeap.h"
+
+/**
+ * \file SCEHeap.c
+ * \copydoc heap
+ * \brief Priority queues
+ *
+ * \file SCEHeap.h
+ * \copydoc heap
+ * \brief Priority queues
+ */
+
+/**
+ * \defgroup heap Priority queues
+ * \ingroup utils
+ * \brief Contiguous d-ary heaps
+ *
+ * A SCE_SHeap keeps its smallest element on top according to a
+ * SCE_FListCompareData, the comparators written for SCE_List_Sort() can be
+ * used. Pushing and popping are O(log n). To change the priority of an
+ * element already in the heap, set a SCE_FHeapMoveFunc: the heap reports
+ * through it the index of every element it moves, which can be stored in
+ * the element and given to SCE_Heap_Update() or SCE_Heap_Remove().
+ *
+ * Binary heaps are the default, 4-ary heaps are often faster for large
+ * heaps since they are shallower and the children of a node share cache
+ * lines.
+ */
+
+/** @{ */
+
+#define SCE_HEAP_MIN_CAPACITY 16
+
+static void SCE_Heap_Put (SCE_SHeap *h, size_t i, void *data)
+{
+    h->data[i] = data;
+    if (h->move)
+        h->move (data, i);
+}
+
+/* moves the element \p data up from the index \p i */
+static void SCE_Heap_SiftUp (SCE_SHeap *h, size_t i, void *data)
+{
+    while (i > 0) {
+        size_t parent = (i - 1) / h->arity;
+        if (h->cmp (data, h->data[parent]) >= 0)
+            break;
+        SCE_Heap_Put (h, i, h->data[parent]);
+        i = parent;
+    }
+    SCE_Heap_Put (h, i, data);
+}
+/* moves the element \p data down from the index \p i */
+static void SCE_Heap_SiftDown (SCE_SHeap *h, size_t i, void *data)
+{
+    for (;;) {
+        size_t first = i * h->arity + 1, best, c, end;
+        if (first >= h->size)
+            break;
+        end = first + h->arity;
+        if (end > h->size)
+            end = h->size;
+        best = first;
+        for (c = first + 1; c < end; c++) {
+            if (h->cmp (h->data[c], h->data[best]) < 0)
+                best = c;
+        }
+        if (h->cmp (h->data[best], data) >= 0)
+            break;
+        SCE_Heap_Put (h, i, h->data[best]);
+        i = best;
+    }
+    SCE_Heap_Put (h, i, data);
+}
+
+
+/**
+ * \brief Initializes a heap
+ * \param h the heap to initialize
+ * \param cmp comparison function, the element on top is the one for which
+ * it returns a negative value against all the others
+ */
+void SCE_Heap_Init (SCE_SHeap *h, SCE_FListCompareData cmp)
+{
+    h->data = NULL;
+    h->size = h->capacity = 0;
+    h->arity = 2;
+    h->cmp = cmp;
+    h->move = NULL;
+}
+/**
+ * \brief Clears a heap, does not free its elements
+ * \param h the heap to clear
+ */
+void SCE_Heap_Clear (SCE_SHeap *h)
+{
+    SCE_free (h->data);
+    h->data = NULL;
+    h->size = h->capacity = 0;
+}
+/**
+ * \brief Creates a new heap
+ * \param cmp comparison function, see SCE_Heap_Init()
+ * \returns a newly allocated heap, or NULL on error
+ */
+SCE_SHeap* SCE_Heap_Create (SCE_FListCompareData cmp)
+{
+    SCE_SHeap *h = NULL;
+    if (!(h = SCE_malloc (sizeof *h)))
+        SCEE_LogSrc ();
+    else
+        SCE_Heap_Init (h, cmp);
+    return h;
+}
+/**
+ * \brief Deletes a heap
+ * \param h the heap to delete
+ */
+void SCE_Heap_Delete (SCE_SHeap *h)
+{
+    if (h) {
+        SCE_Heap_Clear (h);
+        SCE_free (h);
+    }
+}
+
+/**
+ * \brief Sets the number of children of each node of a heap
+ * \param h an empty heap
+ * \param arity from 2 (default) to SCE_HEAP_MAX_ARITY
+ */
+void SCE_Heap_SetArity (SCE_SHeap *h, unsigned int arity)
+{
+    if (arity < 2)
+        arity = 2;
+    else if (arity > SCE_HEAP_MAX_ARITY)
+        arity = SCE_HEAP_MAX_ARITY;
+    h->arity = arity;
+}
+/**
+ * \brief Sets the function receiving the indices of the elements
+ * \sa SCE_FHeapMoveFunc, SCE_Heap_Update()
+ */
+void SCE_Heap_SetMoveFunc (SCE_SHeap *h, SCE_FHeapMoveFunc f)
+{
+    h->move = f;
+}
+
+/**
+ * \brief Makes room for a number of elements
+ * \param h a heap
+ * \param n number of elements \p h should be able to hold
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_Heap_Reserve (SCE_SHeap *h, size_t n)
+{
+    void **data = NULL;
+    size_t cap = h->capacity;
+
+    if (n <= cap)
+        return SCE_OK;
+    if (cap < SCE_HEAP_MIN_CAPACITY)
+        cap = SCE_HEAP_MIN_CAPACITY;
+    while (cap < n)
+        cap *= 2;
+    if (!(data = SCE_realloc (h->data, cap * sizeof *data))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    h->data = data;
+    h->capacity = cap;
+    return SCE_OK;
+}
+/**
+ * \brief Removes all the elements of a heap, keeps its memory
+ *
+ * The SCE_FHeapMoveFunc is not called.
+ */
+void SCE_Heap_Flush (SCE_SHeap *h)
+{
+    h->size = 0;
+}
+/**
+ * \brief Adds an element to a heap
+ * \param h a heap
+ * \param data the element to add
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_Heap_Push (SCE_SHeap *h, void *data)
+{
+    if (h->size == h->capacity && SCE_Heap_Reserve (h, h->size + 1) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    h->size++;
+    SCE_Heap_SiftUp (h, h->size - 1, data);
+    return SCE_OK;
+}
+/**
+ * \brief Adds several elements to a heap at once
+ * \param h a heap
+ * \param data the elements to add
+ * \param n number of elements in \p data
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The heap is rebuilt from the bottom in O(n), which is faster than
+ * pushing the elements one by one when \p n is not small compared to the
+ * size of the heap.
+ */
+int SCE_Heap_PushAll (SCE_SHeap *h, void **data, size_t n)
+{
+    size_t i;
+
+    if (SCE_Heap_Reserve (h, h->size + n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (&h->data[h->size], data, n * sizeof *data);
+    h->size += n;
+    if (h->size < 2) {
+        if (h->size && h->move)
+            h->move (h->data[0], 0);
+        return SCE_OK;
+    }
+    /* the moved elements are reported by the sifts, leaves which do not
+       move are reported here */
+    if (h->move) {
+        for (i = (h->size - 2) / h->arity + 1; i < h->size; i++)
+            h->move (h->data[i], i);
+    }
+    for (i = (h->size - 2) / h->arity + 1; i-- > 0;)
+        SCE_Heap_SiftDown (h, i, h->data[i]);
+    return SCE_OK;
+}
+/**
+ * \brief Gets the top element of a heap
+ * \returns the smallest element, or NULL if \p h is empty
+ */
+void* SCE_Heap_Peek (const SCE_SHeap *h)
+{
+    return h->size ? h->data[0] : NULL;
+}
+/**
+ * \brief Removes the top element of a heap
+ * \returns the smallest element, or NULL if \p h is empty
+ */
+void* SCE_Heap_Pop (SCE_SHeap *h)
+{
+    if (!h->size)
+        return NULL;
+    return SCE_Heap_Remove (h, 0);
+}
+/**
+ * \brief Restores the order of a heap after the priority of an element
+ * changed
+ * \param h a heap
+ * \param i index of the element, as given to the SCE_FHeapMoveFunc
+ *
+ * The priority can be raised or lowered.
+ */
+void SCE_Heap_Update (SCE_SHeap *h, size_t i)
+{
+    void *data = h->data[i];
+    if (i > 0 && h->cmp (data, h->data[(i - 1) / h->arity]) < 0)
+        SCE_Heap_SiftUp (h, i, data);
+    else
+        SCE_Heap_SiftDown (h, i, data);
+}
+/**
+ * \brief Removes any element of a heap
+ * \param h a heap
+ * \param i index of the element, as given to the SCE_FHeapMoveFunc
+ * \returns the removed element
+ */
+void* SCE_Heap_Remove (SCE_SHeap *h, size_t i)
+{
+    void *data = h->data[i];
+    void *last = h->data[--h->size];
+
+    if (i < h->size) {
+        h->data[i] = last;
+        SCE_Heap_Update (h, i);
+    }
+    if (h->move)
+        h->move (data, SCE_HEAP_NO_INDEX);
+    return data;
+}
+/**
+ * \brief Gets the number of elements of a heap
+ */
+size_t SCE_Heap_GetSize (const SCE_SHeap *h)
+{
+    return h->size;
+}
+
+/** @} */
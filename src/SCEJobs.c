@@ -0,0 +1,542 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 18/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEQueue.h"
+#include "SCE/utils/SCEJobs.h"
+
+/**
+ * \file SCEJobs.c
+ * \copydoc jobs
+ * \brief Work-stealing job system
+ *
+ * \file SCEJobs.h
+ * \copydoc jobs
+ * \brief Work-stealing job system
+ */
+
+/**
+ * \defgroup jobs Work-stealing job system
+ * \ingroup utils
+ * \brief Shared worker threads running jobs
+ *
+ * SCE_Init_Utils() starts one worker thread per processor but one, and
+ * SCE_Quit_Utils() stops them. Each worker owns a Chase-Lev deque: it
+ * pushes and pops the jobs it creates at the bottom, last in first out,
+ * while idle workers steal the oldest jobs from the top of the deques of
+ * the others. Other threads submitting jobs get a deque of their own too,
+ * up to SCE_JOBS_MAX_EXTERNAL of them, the following ones go through a
+ * shared SCE_SMPMCRing. Idle workers sleep once there is nothing to steal.
+ *
+ * A job counts its unfinished children: SCE_Job_Wait() returns once the
+ * job and all its children, set with SCE_Job_SetParent(), are done. A
+ * waiting thread runs other jobs meanwhile instead of blocking, so jobs
+ * can wait for their own children. SCE_Jobs_ParallelFor() builds on that
+ * to split ranges of indices over the workers, SCEWorkers, the parallel
+ * list traversals, SCE_Type_Convert() and SCE_Media_LoadMany() use it.
+ *
+ * Without worker threads (single processor or before SCE_Init_Utils())
+ * jobs run as soon as they are submitted.
+ */
+
+/** @{ */
+
+/* number of jobs a deque can hold, a power of two */
+#define SCE_JOBS_DEQUE_SIZE 4096
+/* capacity of the queue of jobs submitted by other threads */
+#define SCE_JOBS_INJECT_SIZE 4096
+/* number of idle rounds before a worker goes to sleep */
+#define SCE_JOBS_SPINS 64
+/* number of deques for the threads that are not workers */
+#define SCE_JOBS_MAX_EXTERNAL 8
+
+typedef struct sce_sjobdeque SCE_SJobDeque;
+struct sce_sjobdeque {
+    SCE_CACHE_ALIGNED long top;         /* stolen end */
+    SCE_CACHE_ALIGNED long bottom;      /* owner end */
+    SCE_SJob *jobs[SCE_JOBS_DEQUE_SIZE];
+};
+
+typedef struct sce_sjobworker SCE_SJobWorker;
+struct sce_sjobworker {
+    SCE_SJobDeque deque;
+    pthread_t thread;
+    unsigned int seed;                  /* picks the victims */
+    int owned;                          /* is a thread using the deque? */
+};
+
+static SCE_SJobWorker *workers = NULL;
+static unsigned int n_workers = 0;     /* number of deques */
+static unsigned int n_threads = 0;     /* number of started threads */
+static unsigned int generation = 0;    /* changes on start and stop */
+static pthread_key_t self_key;
+static SCE_SMPMCRing inject;
+
+static pthread_mutex_t sleep_m = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sleep_c = PTHREAD_COND_INITIALIZER;
+static int sleepers = 0;                /* threads waiting on sleep_c */
+static int quit = SCE_FALSE;
+
+/* deque of the current thread, valid if self_gen is generation */
+static __thread SCE_SJobWorker *self = NULL;
+static __thread unsigned int self_gen = 0;
+
+
+/* Chase-Lev deque, with the memory orders of "Correct and Efficient
+   Work-Stealing for Weak Memory Models" by Le, Pop, Cohen and Zappa
+   Nardelli */
+static int SCE_Jobs_Push (SCE_SJobDeque *d, SCE_SJob *job)
+{
+    long b = __atomic_load_n (&d->bottom, __ATOMIC_RELAXED);
+    long t = __atomic_load_n (&d->top, __ATOMIC_ACQUIRE);
+
+    if (b - t >= SCE_JOBS_DEQUE_SIZE)
+        return SCE_FALSE;
+    __atomic_store_n (&d->jobs[b & (SCE_JOBS_DEQUE_SIZE - 1)], job,
+                      __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+    __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return SCE_TRUE;
+}
+static SCE_SJob* SCE_Jobs_Take (SCE_SJobDeque *d)
+{
+    long b = __atomic_load_n (&d->bottom, __ATOMIC_RELAXED) - 1;
+    long t;
+    SCE_SJob *job = NULL;
+
+    __atomic_store_n (&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    t = __atomic_load_n (&d->top, __ATOMIC_RELAXED);
+    if (t <= b) {
+        job = __atomic_load_n (&d->jobs[b & (SCE_JOBS_DEQUE_SIZE - 1)],
+                               __ATOMIC_RELAXED);
+        if (t == b) {
+            /* last job, race with the thieves */
+            if (!__atomic_compare_exchange_n (&d->top, &t, t + 1, SCE_FALSE,
+                                              __ATOMIC_SEQ_CST,
+                                              __ATOMIC_RELAXED))
+                job = NULL;
+            __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else
+        __atomic_store_n (&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return job;
+}
+static SCE_SJob* SCE_Jobs_Steal (SCE_SJobDeque *d)
+{
+    long t = __atomic_load_n (&d->top, __ATOMIC_ACQUIRE);
+    long b;
+    SCE_SJob *job = NULL;
+
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    b = __atomic_load_n (&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b)
+        return NULL;
+    job = __atomic_load_n (&d->jobs[t & (SCE_JOBS_DEQUE_SIZE - 1)],
+                           __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n (&d->top, &t, t + 1, SCE_FALSE,
+                                      __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return NULL;            /* lost the race, try elsewhere */
+    return job;
+}
+
+/* is there any job to run? */
+static int SCE_Jobs_HasWork (void)
+{
+    unsigned int i;
+
+    if (SCE_MPMCRing_GetSize (&inject))
+        return SCE_TRUE;
+    for (i = 0; i < n_workers; i++) {
+        SCE_SJobDeque *d = &workers[i].deque;
+        if (__atomic_load_n (&d->bottom, __ATOMIC_SEQ_CST) >
+            __atomic_load_n (&d->top, __ATOMIC_SEQ_CST))
+            return SCE_TRUE;
+    }
+    return SCE_FALSE;
+}
+/* wakes a sleeping worker after a job was submitted */
+static void SCE_Jobs_Notify (void)
+{
+    /* pairs with the increment of sleepers in SCE_Jobs_Sleep() */
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    if (__atomic_load_n (&sleepers, __ATOMIC_RELAXED)) {
+        pthread_mutex_lock (&sleep_m);
+        /* the woken worker does not decrement sleepers, so the next
+           submissions do not signal it again before it runs */
+        if (sleepers) {
+            __atomic_sub_fetch (&sleepers, 1, __ATOMIC_RELAXED);
+            pthread_cond_signal (&sleep_c);
+        }
+        pthread_mutex_unlock (&sleep_m);
+    }
+}
+static void SCE_Jobs_Sleep (void)
+{
+    pthread_mutex_lock (&sleep_m);
+    __atomic_add_fetch (&sleepers, 1, __ATOMIC_SEQ_CST);
+    if (!quit && !SCE_Jobs_HasWork ())
+        pthread_cond_wait (&sleep_c, &sleep_m);
+    else
+        __atomic_sub_fetch (&sleepers, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock (&sleep_m);
+}
+
+/* gives back the deque of an external thread when it exits */
+static void SCE_Jobs_Release (void *w)
+{
+    __atomic_store_n (&((SCE_SJobWorker*)w)->owned, SCE_FALSE,
+                      __ATOMIC_RELEASE);
+}
+/* gets the deque of the calling thread, the first call from a thread that
+   is not a worker picks a free external deque, if any */
+static SCE_SJobWorker* SCE_Jobs_GetSelf (void)
+{
+    unsigned int i;
+
+    if (self_gen == generation)
+        return self;
+    self = NULL;
+    self_gen = generation;
+    for (i = n_threads; i < n_workers; i++) {
+        int owned = SCE_FALSE;
+        if (__atomic_compare_exchange_n (&workers[i].owned, &owned, SCE_TRUE,
+                                         SCE_FALSE, __ATOMIC_ACQUIRE,
+                                         __ATOMIC_RELAXED)) {
+            self = &workers[i];
+            pthread_setspecific (self_key, self);
+            break;
+        }
+    }
+    return self;
+}
+
+/* gets a job to run: from the own deque of the calling worker, then from
+   the submitted jobs, then from the other workers */
+static SCE_SJob* SCE_Jobs_Find (void)
+{
+    SCE_SJob *job = NULL;
+    unsigned int i, start = 0;
+
+    if (self) {
+        if ((job = SCE_Jobs_Take (&self->deque)))
+            return job;
+        self->seed = self->seed * 1103515245u + 12345u;
+        start = self->seed >> 16;
+    }
+    if ((job = SCE_MPMCRing_Pop (&inject)))
+        return job;
+    for (i = 0; i < n_workers; i++) {
+        SCE_SJobWorker *w = &workers[(start + i) % n_workers];
+        if (w != self && (job = SCE_Jobs_Steal (&w->deque)))
+            return job;
+    }
+    return NULL;
+}
+
+/* releases one reference of a job, and of its parents once done */
+static void SCE_Jobs_Finish (SCE_SJob *job)
+{
+    while (job) {
+        /* job may be released by its waiter as soon as pending is 0 */
+        SCE_SJob *parent = job->parent;
+        if (__atomic_sub_fetch (&job->pending, 1, __ATOMIC_ACQ_REL))
+            break;
+        job = parent;
+    }
+}
+static void SCE_Jobs_Execute (SCE_SJob *job)
+{
+    if (job->func)
+        job->func (job, job->data);
+    SCE_Jobs_Finish (job);
+}
+
+static void* SCE_Jobs_Loop (void *data)
+{
+    SCE_SJob *job = NULL;
+    unsigned int idle = 0;
+
+    self = data;
+    self_gen = generation;
+    while (!__atomic_load_n (&quit, __ATOMIC_ACQUIRE)) {
+        if ((job = SCE_Jobs_Find ())) {
+            SCE_Jobs_Execute (job);
+            idle = 0;
+        } else if (++idle < SCE_JOBS_SPINS)
+            sched_yield ();
+        else {
+            SCE_Jobs_Sleep ();
+            idle = 0;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * \internal
+ * \brief Starts the worker threads
+ */
+int SCE_Init_Jobs (void)
+{
+    long n_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+    unsigned int i, n = n_cpus > 1 ? n_cpus - 1 : 0;
+
+    if (n > SCE_JOBS_MAX_THREADS)
+        n = SCE_JOBS_MAX_THREADS;
+    quit = SCE_FALSE;
+    if (!n)
+        return SCE_OK;
+    if (SCE_MPMCRing_Init (&inject, SCE_JOBS_INJECT_SIZE) < 0)
+        goto fail;
+    if (!(workers = SCE_malloc_aligned (SCE_CACHE_LINE_SIZE,
+                                        (n + SCE_JOBS_MAX_EXTERNAL) *
+                                        sizeof *workers))) {
+        SCE_MPMCRing_Clear (&inject);
+        goto fail;
+    }
+    for (i = 0; i < n + SCE_JOBS_MAX_EXTERNAL; i++) {
+        workers[i].deque.top = workers[i].deque.bottom = 0;
+        workers[i].seed = i + 1;
+        workers[i].owned = i < n;
+    }
+    pthread_key_create (&self_key, SCE_Jobs_Release);
+    generation++;
+    /* the deques must exist before any worker steals */
+    n_workers = n + SCE_JOBS_MAX_EXTERNAL;
+    /* the deques of the workers that fail to start stay empty */
+    for (n_threads = 0; n_threads < n; n_threads++) {
+        int err = pthread_create (&workers[n_threads].thread, NULL,
+                                  SCE_Jobs_Loop, &workers[n_threads]);
+        if (err) {
+            /* not fatal, jobs run on fewer threads */
+            SCEE_LogMsg ("cannot start worker thread: %d", err);
+            SCEE_Clear ();
+            break;
+        }
+    }
+    if (!n_threads)
+        SCE_Quit_Jobs ();
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+/**
+ * \internal
+ * \brief Stops the worker threads, every job must be done
+ */
+void SCE_Quit_Jobs (void)
+{
+    unsigned int i;
+
+    if (!workers)
+        return;
+    pthread_mutex_lock (&sleep_m);
+    __atomic_store_n (&quit, SCE_TRUE, __ATOMIC_RELEASE);
+    pthread_cond_broadcast (&sleep_c);
+    pthread_mutex_unlock (&sleep_m);
+    for (i = 0; i < n_threads; i++)
+        pthread_join (workers[i].thread, NULL);
+    /* no destructor must touch the deques from now on */
+    pthread_key_delete (self_key);
+    generation++;
+    SCE_free_aligned (workers);
+    workers = NULL;
+    n_workers = n_threads = 0;
+    sleepers = 0;
+    SCE_MPMCRing_Clear (&inject);
+}
+
+/**
+ * \brief Gets the number of threads running jobs
+ * \returns the number of worker threads plus one for the calling thread,
+ * which runs jobs while it waits
+ */
+unsigned int SCE_Jobs_GetCount (void)
+{
+    return n_threads + 1;
+}
+
+/**
+ * \brief Initializes a job
+ * \param job the job to initialize
+ * \param func function of \p job, NULL for a job only waiting for its
+ * children
+ * \param data user data given to \p func
+ */
+void SCE_Job_Init (SCE_SJob *job, SCE_FJobFunc func, void *data)
+{
+    job->func = func;
+    job->data = data;
+    job->parent = NULL;
+    job->pending = 1;
+}
+/**
+ * \brief Makes a job a child of another one
+ * \param job a job not submitted yet
+ * \param parent the job that will wait for \p job, it must not be done
+ *
+ * \p parent is done only once \p job is. Typically \p parent is the job
+ * creating \p job, or a job without function gathering several jobs.
+ */
+void SCE_Job_SetParent (SCE_SJob *job, SCE_SJob *parent)
+{
+    job->parent = parent;
+    __atomic_add_fetch (&parent->pending, 1, __ATOMIC_RELAXED);
+}
+/**
+ * \brief Submits a job, can be called from any thread
+ * \param job the job to run, it must stay alive until it is done
+ *
+ * A job without function is marked as done immediately, it still waits
+ * for its children.
+ * \sa SCE_Job_Wait()
+ */
+void SCE_Job_Run (SCE_SJob *job)
+{
+    if (!job->func) {
+        SCE_Jobs_Finish (job);
+        return;
+    }
+    if (!n_threads) {
+        SCE_Jobs_Execute (job);
+        return;
+    }
+    if (SCE_Jobs_GetSelf ()) {
+        if (!SCE_Jobs_Push (&self->deque, job)) {
+            SCE_Jobs_Execute (job); /* deque full */
+            return;
+        }
+    } else if (!SCE_MPMCRing_Push (&inject, job)) {
+        SCE_Jobs_Execute (job);
+        return;
+    }
+    SCE_Jobs_Notify ();
+}
+/**
+ * \brief Waits for a job and all its children, running other jobs
+ * meanwhile
+ * \param job a submitted job
+ */
+void SCE_Job_Wait (SCE_SJob *job)
+{
+    SCE_SJob *other = NULL;
+
+    SCE_Jobs_GetSelf ();
+    while (__atomic_load_n (&job->pending, __ATOMIC_ACQUIRE)) {
+        if ((other = SCE_Jobs_Find ()))
+            SCE_Jobs_Execute (other);
+        else
+            sched_yield ();
+    }
+}
+/**
+ * \brief Are a job and all its children done?
+ */
+int SCE_Job_IsDone (SCE_SJob *job)
+{
+    return !__atomic_load_n (&job->pending, __ATOMIC_ACQUIRE);
+}
+
+
+typedef struct sce_sjobrange SCE_SJobRange;
+struct sce_sjobrange {
+    SCE_SJob job;
+    size_t begin, end;
+    size_t grain;
+    SCE_FJobRangeFunc f;
+    void *data;
+};
+
+/* runs a range: splits off its upper halves as children until it is not
+   larger than the grain, runs what is left and waits for the children */
+static void SCE_Jobs_RangeJob (SCE_SJob *job, void *data)
+{
+    SCE_SJobRange *r = data;
+    SCE_SJobRange children[sizeof (size_t) * 8];
+    SCE_SJob group;
+    size_t begin = r->begin, end = r->end;
+    unsigned int n = 0;
+    (void)job;
+
+    SCE_Job_Init (&group, NULL, NULL);
+    while (end - begin > r->grain) {
+        size_t mid = begin + (end - begin) / 2;
+        SCE_SJobRange *c = &children[n++];
+        *c = *r;
+        c->begin = mid;
+        c->end = end;
+        SCE_Job_Init (&c->job, SCE_Jobs_RangeJob, c);
+        SCE_Job_SetParent (&c->job, &group);
+        SCE_Job_Run (&c->job);
+        end = mid;
+    }
+    r->f (begin, end, r->data);
+    if (n) {
+        SCE_Job_Run (&group);
+        SCE_Job_Wait (&group);
+    }
+}
+
+/**
+ * \brief Calls a function on the parts of a range of indices, in parallel
+ * \param begin first index
+ * \param end index following the last one
+ * \param grain maximum size of a part, 0 is taken as 1
+ * \param f function called on each part, must be thread safe
+ * \param data user data given to \p f
+ *
+ * The range is split in halves recursively, each split can be stolen by
+ * another worker, until the parts are not larger than \p grain. Returns
+ * once every part is done. The grain should be large enough for \p f to
+ * take a few microseconds. Can be called from a job.
+ */
+void SCE_Jobs_ParallelFor (size_t begin, size_t end, size_t grain,
+                           SCE_FJobRangeFunc f, void *data)
+{
+    SCE_SJobRange r;
+
+    if (!grain)
+        grain = 1;
+    if (end <= begin)
+        return;
+    if (!n_threads || end - begin <= grain) {
+        f (begin, end, data);
+        return;
+    }
+    r.begin = begin;
+    r.end = end;
+    r.grain = grain;
+    r.f = f;
+    r.data = data;
+    SCE_Job_Init (&r.job, SCE_Jobs_RangeJob, &r);
+    SCE_Jobs_RangeJob (&r.job, &r);
+}
+
+/** @} */
@@ -17,9 +17,11 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 21/09/2007
-   updated: 14/03/2012 */
+   updated: 18/10/2026 */
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 
 #include "SCE/utils/SCEMacros.h"
 #include "SCE/utils/SCEError.h"
@@ -42,6 +44,192 @@
  * @{
  */
 
+/* bumped by the functions changing a list they are not given, the lengths
+   cached before are then recomputed, see SCE_List_GetLength() */
+static unsigned long long list_epoch = 1;
+
+/* invalidates the cached length of every list */
+static void SCE_List_Touch (void)
+{
+    __atomic_add_fetch (&list_epoch, 1, __ATOMIC_RELAXED);
+}
+static unsigned long long SCE_List_GetEpoch (void)
+{
+    return __atomic_load_n (&list_epoch, __ATOMIC_RELAXED);
+}
+/* lists joined to others share their iterators, their length is not
+   cached */
+static int SCE_List_IsJoined (const SCE_SList *l)
+{
+    return l->first.prev || l->last.next;
+}
+
+/* hash table of the iterators of a list, keyed by their data */
+struct sce_slistindex {
+    SCE_SListIterator **its;    /* NULL for empty slots */
+    size_t size;                /* number of slots, power of two */
+    size_t n;                   /* number of used slots */
+    unsigned long long epoch;   /* epoch of the list when the index was
+                                   built, 0 if it has to be rebuilt */
+};
+
+#define SCE_LIST_INDEX_MIN_SIZE 16
+
+static size_t SCE_List_Hash (const SCE_SListIndex *x, const void *data)
+{
+    uint64_t h = (uintptr_t)data;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h & (x->size - 1);
+}
+static void SCE_List_IndexPut (SCE_SListIndex *x, SCE_SListIterator *it)
+{
+    size_t i = SCE_List_Hash (x, it->data);
+    while (x->its[i])
+        i = (i + 1) & (x->size - 1);
+    x->its[i] = it;
+    x->n++;
+}
+/* makes room for \p n iterators, keeps the current ones */
+static int SCE_List_IndexReserve (SCE_SListIndex *x, size_t n)
+{
+    SCE_SListIterator **old = x->its;
+    size_t i, old_size = x->size, size = SCE_LIST_INDEX_MIN_SIZE;
+
+    while (size * 3 < n * 4)
+        size *= 2;
+    if (size <= old_size)
+        return SCE_OK;
+    if (!(x->its = SCE_calloc (size, sizeof *x->its))) {
+        x->its = old;
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    x->size = size;
+    x->n = 0;
+    for (i = 0; i < old_size; i++) {
+        if (old[i])
+            SCE_List_IndexPut (x, old[i]);
+    }
+    SCE_free (old);
+    return SCE_OK;
+}
+static void SCE_List_IndexRemove (SCE_SListIndex *x, SCE_SListIterator *it)
+{
+    size_t i = SCE_List_Hash (x, it->data), j, k;
+
+    while (x->its[i] && x->its[i] != it)
+        i = (i + 1) & (x->size - 1);
+    if (!x->its[i])
+        return;
+    /* backward shift deletion: moves back the following iterators which
+       would no longer be reachable from their hash */
+    for (j = (i + 1) & (x->size - 1); x->its[j]; j = (j + 1) & (x->size - 1)) {
+        k = SCE_List_Hash (x, x->its[j]->data);
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+            x->its[i] = x->its[j];
+            i = j;
+        }
+    }
+    x->its[i] = NULL;
+    x->n--;
+}
+/* is the index of \p l up to date? */
+static int SCE_List_IndexIsValid (const SCE_SList *l)
+{
+    return l->index && l->index->epoch && l->index->epoch == l->epoch &&
+        l->epoch == SCE_List_GetEpoch () && !SCE_List_IsJoined (l);
+}
+/* called after \p it has been added to \p l */
+static void SCE_List_IndexAdd (SCE_SList *l, SCE_SListIterator *it)
+{
+    if (!SCE_List_IndexIsValid (l))
+        return;
+    if (SCE_List_IndexReserve (l->index, l->index->n + 1) < 0) {
+        /* not fatal, the index will be rebuilt */
+        SCEE_Clear ();
+        l->index->epoch = 0;
+    } else
+        SCE_List_IndexPut (l->index, it);
+}
+/* called before \p it is removed from \p l */
+static void SCE_List_IndexDel (SCE_SList *l, SCE_SListIterator *it)
+{
+    if (SCE_List_IndexIsValid (l))
+        SCE_List_IndexRemove (l->index, it);
+}
+
+static void SCE_List_IndexSetStale (SCE_SList *l)
+{
+    if (l->index)
+        l->index->epoch = 0;
+}
+
+/**
+ * \brief Invalidates the cached length and the index of a list
+ * \param l a list
+ *
+ * Forces the length of \p l to be recomputed on its next query. The library
+ * does it by itself, this is only needed when \p l has been modified
+ * behind its back, like by the SCE_LIST_ABUSIVE_MACRO macros. Other lists
+ * are not affected.
+ * \sa SCE_List_GetLength(), SCE_List_EnableIndex()
+ */
+void SCE_List_SetDirty (SCE_SList *l)
+{
+    l->epoch = 0;
+    SCE_List_IndexSetStale (l);
+}
+static void SCE_List_AddLength (SCE_SList *l, int n)
+{
+    if (SCE_List_IsJoined (l))
+        SCE_List_SetDirty (l);
+    else
+        l->length += n;
+}
+
+/* raw linking functions, the public ones also invalidate the lengths */
+static void SCE_List_Link (SCE_SListIterator *it, SCE_SListIterator *new)
+{
+    it->next = new;
+    new->prev = it;
+}
+static void SCE_List_LinkBefore (SCE_SListIterator *it,
+                                 SCE_SListIterator *new)
+{
+    if (it->prev)
+        it->prev->next = new;
+    new->prev = it->prev;
+    new->next = it;
+    it->prev = new;
+}
+static void SCE_List_LinkAfter (SCE_SListIterator *it, SCE_SListIterator *new)
+{
+    if (it->next)
+        it->next->prev = new;
+    new->next = it->next;
+    new->prev = it;
+    it->next = new;
+}
+static void SCE_List_Unlink (SCE_SListIterator *it)
+{
+    if (it->next)
+        it->next->prev = it->prev;
+    if (it->prev) {
+        it->prev->next = it->next;
+        it->prev = NULL;
+    }
+    it->next = NULL;
+}
+static void SCE_List_Unlinkl (SCE_SListIterator *it)
+{
+    it->next->prev = it->prev;
+    it->prev->next = it->next;
+    it->next = NULL;
+    it->prev = NULL;
+}
+
 /**
  * \brief Initializes an iterator
  */
@@ -71,6 +259,27 @@ void SCE_List_DeleteIt (SCE_SListIterator *it)
     SCE_free (it);
 }
 
+/* creates an iterator for the list \p l */
+static SCE_SListIterator* SCE_List_NewIt (SCE_SList *l)
+{
+    SCE_SListIterator *it = NULL;
+    if (!l->pool)
+        return SCE_List_CreateIt ();
+    if (!(it = SCE_Pool_Alloc (l->pool)))
+        SCEE_LogSrc ();
+    else
+        SCE_List_InitIt (it);
+    return it;
+}
+/* deletes an iterator created by SCE_List_NewIt() */
+static void SCE_List_FreeIt (SCE_SList *l, SCE_SListIterator *it)
+{
+    if (l->pool)
+        SCE_Pool_Free (l->pool, it);
+    else
+        SCE_List_DeleteIt (it);
+}
+
 static void SCE_List_JoinFirstLast (SCE_SList *l)
 {
     l->first.next = &l->last;
@@ -94,6 +303,10 @@ void SCE_List_Init (SCE_SList *l)
     l->f2arg = NULL;
     /* TODO: kick useless calls of CanDeleteIterators() in the engine */
     l->canfree = SCE_FALSE;     /* by default, CANT free iterators */
+    l->pool = NULL;
+    l->length = 0;
+    l->epoch = SCE_List_GetEpoch ();
+    l->index = NULL;
 }
 /**
  * \brief Creates a new list
@@ -150,6 +363,12 @@ void SCE_List_Flush (SCE_SList *l)
         l->last.prev->next = NULL;
         SCE_List_JoinFirstLast (l);
     }
+    l->length = 0;
+    l->epoch = SCE_List_GetEpoch ();
+    if (l->index) {
+        memset (l->index->its, 0, l->index->size * sizeof *l->index->its);
+        l->index->n = 0;
+    }
 }
 /**
  * \brief Clears a list
@@ -183,6 +402,7 @@ void SCE_List_Delete (SCE_SList *l)
     if (l) {
         if (l->f || l->f2 || l->canfree)
             SCE_List_Clear (l);
+        SCE_List_DisableIndex (l);
         SCE_free (l);
     }
 }
@@ -224,6 +444,114 @@ void SCE_List_SetFreeFunc2 (SCE_SList *l, SCE_FListFreeFunc2 f, void *a)
     l->f2arg = a;
 }
 
+/**
+ * \brief Sets the pool of the iterators of a list
+ * \param l A list
+ * \param pool a pool of objects of size sizeof (SCE_SListIterator), or NULL
+ * to go back to SCE_List_CreateIt()
+ *
+ * SCE_List_PrependNewl() and SCE_List_AppendNewl() take their iterators from
+ * \p pool, and the list gives them back to \p pool when it can delete its
+ * iterators (see SCE_List_CanDeleteIterators()). Several lists can share
+ * the same pool. Set the pool while \p l is empty.
+ * \sa SCE_Pool_Init()
+ */
+void SCE_List_SetPool (SCE_SList *l, SCE_SPool *pool)
+{
+    l->pool = pool;
+}
+/**
+ * \brief Gets the pool of the iterators of a list
+ * \sa SCE_List_SetPool()
+ */
+SCE_SPool* SCE_List_GetPool (const SCE_SList *l)
+{
+    return l->pool;
+}
+
+/**
+ * \brief Indexes the elements of a list by their data
+ * \param l a list
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * Makes SCE_List_LocateIterator(), SCE_List_RemoveFromData() and
+ * SCE_List_EraseFromData() O(1) when no comparison function is given, at the
+ * cost of a hash table of one pointer per element. SCE_List_LocateIndex()
+ * finds the element in O(1) but still counts its position in O(n), without
+ * comparing the data. The index is maintained by the functions taking \p l
+ * as argument; like the cached length (see SCE_List_GetLength()) it is
+ * rebuilt on the next lookup after a function working on bare iterators,
+ * like SCE_List_Remove() or SCE_List_SetData(), modified any list, and it is
+ * not used while \p l is joined to other lists. SCE_List_SetDatal() keeps
+ * the index valid. If a data is stored several times in \p l, the lookups
+ * return any of its iterators.
+ * \note Call SCE_List_DisableIndex() before dropping a list initialized by
+ * SCE_List_Init(), SCE_List_Delete() does it for you.
+ * \sa SCE_List_DisableIndex()
+ */
+int SCE_List_EnableIndex (SCE_SList *l)
+{
+    if (l->index)
+        return SCE_OK;
+    if (!(l->index = SCE_malloc (sizeof *l->index))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    l->index->its = NULL;
+    l->index->size = l->index->n = 0;
+    l->index->epoch = 0;        /* built on the first lookup */
+    return SCE_OK;
+}
+/**
+ * \brief Frees the index of a list
+ * \sa SCE_List_EnableIndex()
+ */
+void SCE_List_DisableIndex (SCE_SList *l)
+{
+    if (l->index) {
+        SCE_free (l->index->its);
+        SCE_free (l->index);
+        l->index = NULL;
+    }
+}
+/* rebuilds the index of \p l if needed, returns SCE_FALSE if it cannot be
+   used */
+static int SCE_List_IndexUpdate (SCE_SList *l)
+{
+    SCE_SListIterator *it = NULL;
+    unsigned int n;
+
+    if (!l->index || SCE_List_IsJoined (l))
+        return SCE_FALSE;
+    if (SCE_List_IndexIsValid (l))
+        return SCE_TRUE;
+    n = SCE_List_GetLength (l);  /* updates l->epoch */
+    if (SCE_List_IndexReserve (l->index, n) < 0) {
+        SCEE_Clear ();
+        return SCE_FALSE;
+    }
+    memset (l->index->its, 0, l->index->size * sizeof *l->index->its);
+    l->index->n = 0;
+    SCE_List_ForEach (it, l)
+        SCE_List_IndexPut (l->index, it);
+    l->index->epoch = l->epoch;
+    return SCE_TRUE;
+}
+static SCE_SListIterator* SCE_List_IndexLookup (const SCE_SList *l,
+                                                const void *data)
+{
+    SCE_SListIndex *x = l->index;
+    size_t i;
+
+    if (!x->n)
+        return NULL;
+    for (i = SCE_List_Hash (x, data); x->its[i]; i = (i + 1) & (x->size - 1)) {
+        if (x->its[i]->data == data)
+            return x->its[i];
+    }
+    return NULL;
+}
+
 /**
  * \brief Check whether an iterator it attached to a list
  * \param it an iterator
@@ -241,8 +569,8 @@ int SCE_List_IsAttached (const SCE_SListIterator *it)
  */
 void SCE_List_Attach (SCE_SListIterator *it, SCE_SListIterator *new)
 {
-    it->next = new;
-    new->prev = it;
+    SCE_List_Link (it, new);
+    SCE_List_Touch ();
 }
 /**
  * \brief Prepends a list iterator to another one
@@ -251,11 +579,8 @@ void SCE_List_Attach (SCE_SListIterator *it, SCE_SListIterator *new)
  */
 void SCE_List_Prepend (SCE_SListIterator *it, SCE_SListIterator *new)
 {
-    if (it->prev)
-        it->prev->next = new;
-    new->prev = it->prev;
-    new->next = it;
-    it->prev = new;
+    SCE_List_LinkBefore (it, new);
+    SCE_List_Touch ();
 }
 /**
  * \brief Appends a list iterator to another one
@@ -264,11 +589,8 @@ void SCE_List_Prepend (SCE_SListIterator *it, SCE_SListIterator *new)
  */
 void SCE_List_Append (SCE_SListIterator *it, SCE_SListIterator *new)
 {
-    if (it->next)
-        it->next->prev = new;
-    new->next = it->next;
-    new->prev = it;
-    it->next = new;
+    SCE_List_LinkAfter (it, new);
+    SCE_List_Touch ();
 }
 
 #if !SCE_LIST_ABUSIVE_MACRO
@@ -281,6 +603,8 @@ void SCE_List_Prependl (SCE_SList *l, SCE_SListIterator *it)
     it->next = l->first.next;
     l->first.next->prev = it;
     l->first.next = it;
+    SCE_List_AddLength (l, 1);
+    SCE_List_IndexAdd (l, it);
 }
 /**
  * \brief
@@ -291,6 +615,8 @@ void SCE_List_Appendl (SCE_SList *l, SCE_SListIterator *it)
     it->prev = l->last.prev;
     l->last.prev->next = it;
     l->last.prev = it;
+    SCE_List_AddLength (l, 1);
+    SCE_List_IndexAdd (l, it);
 }
 #endif
 
@@ -345,7 +671,7 @@ int SCE_List_AppendNew (SCE_SListIterator *i, void *d)
  */
 int SCE_List_PrependNewl (SCE_SList *l, void *d)
 {
-    SCE_SListIterator *it = SCE_List_CreateIt ();
+    SCE_SListIterator *it = SCE_List_NewIt (l);
     if (!it) {
         SCEE_LogSrc ();
         return SCE_ERROR;
@@ -364,7 +690,7 @@ int SCE_List_PrependNewl (SCE_SList *l, void *d)
  */
 int SCE_List_AppendNewl (SCE_SList *l, void *d)
 {
-    SCE_SListIterator *it = SCE_List_CreateIt ();
+    SCE_SListIterator *it = SCE_List_NewIt (l);
     if (!it) {
         SCEE_LogSrc ();
         return SCE_ERROR;
@@ -380,9 +706,14 @@ int SCE_List_AppendNewl (SCE_SList *l, void *d)
 void SCE_List_PrependAll (SCE_SList *l1, SCE_SList *l2)
 {
     if (SCE_List_HasElements (l2)) {
-        SCE_List_Attach (l2->last.prev, l1->first.next);
-        SCE_List_Attach (&l1->first, l2->first.next);
+        unsigned int n = SCE_List_GetLength (l2);
+        SCE_List_Link (l2->last.prev, l1->first.next);
+        SCE_List_Link (&l1->first, l2->first.next);
+        SCE_List_AddLength (l1, n);
         SCE_List_JoinFirstLast (l2); /* flush */
+        l2->length = 0;
+        SCE_List_IndexSetStale (l1);
+        SCE_List_IndexSetStale (l2);
     }
 }
 /**
@@ -392,9 +723,14 @@ void SCE_List_PrependAll (SCE_SList *l1, SCE_SList *l2)
 void SCE_List_AppendAll (SCE_SList *l1, SCE_SList *l2)
 {
     if (SCE_List_HasElements (l2)) {
-        SCE_List_Attach (l1->last.prev, l2->first.next);
-        SCE_List_Attach (l2->last.prev, &l1->last);
+        unsigned int n = SCE_List_GetLength (l2);
+        SCE_List_Link (l1->last.prev, l2->first.next);
+        SCE_List_Link (l2->last.prev, &l1->last);
+        SCE_List_AddLength (l1, n);
         SCE_List_JoinFirstLast (l2); /* flush */
+        l2->length = 0;
+        SCE_List_IndexSetStale (l1);
+        SCE_List_IndexSetStale (l2);
     }
 }
 
@@ -404,18 +740,14 @@ void SCE_List_AppendAll (SCE_SList *l1, SCE_SList *l2)
  * \param it the iterator to detach
  *
  * Removes the given element \p it if it is inserted. This function checks
- * if the iterator is inserted before remove it.
- * \sa SCE_List_Removel()
+ * if the iterator is inserted before remove it. Use SCE_List_Detach() when
+ * the list is known, it keeps its length cached.
+ * \sa SCE_List_Removel(), SCE_List_Detach()
  */
 void SCE_List_Remove (SCE_SListIterator *it)
 {
-    if (it->next)
-        it->next->prev = it->prev;
-    if (it->prev) {
-        it->prev->next = it->next;
-        it->prev = NULL;
-    }
-    it->next = NULL;
+    SCE_List_Unlink (it);
+    SCE_List_Touch ();
 }
 #if !SCE_LIST_ABUSIVE_MACRO
 /**
@@ -432,12 +764,28 @@ void SCE_List_Remove (SCE_SListIterator *it)
  */
 void SCE_List_Removel (SCE_SListIterator *it)
 {
-    it->next->prev = it->prev;
-    it->prev->next = it->next;
-    it->next = NULL;
-    it->prev = NULL;
+    SCE_List_Unlinkl (it);
+    SCE_List_Touch ();
 }
 #endif
+/**
+ * \brief Removes an element of a given list
+ * \param l the list \p it belongs to
+ * \param it the iterator to detach
+ *
+ * Same as SCE_List_Remove(), but keeps the length of \p l cached: prefer it
+ * when the list is known.
+ * \sa SCE_List_Remove(), SCE_List_GetLength()
+ */
+void SCE_List_Detach (SCE_SList *l, SCE_SListIterator *it)
+{
+    if (it->prev && it->next) {
+        SCE_List_IndexDel (l, it);
+        SCE_List_AddLength (l, -1);
+    }
+    SCE_List_Unlink (it);
+}
+
 /**
  * \brief Removes the first element of a list
  * \param l the SCE_SList from where detach data
@@ -449,7 +797,9 @@ void SCE_List_Removel (SCE_SListIterator *it)
 SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList *l)
 {
     SCE_SListIterator *it = l->first.next;
-    SCE_List_Removel (it);
+    SCE_List_IndexDel (l, it);
+    SCE_List_Unlinkl (it);
+    SCE_List_AddLength (l, -1);
     return it;
 }
 /**
@@ -463,7 +813,9 @@ SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList *l)
 SCE_SListIterator* SCE_List_RemoveLast (SCE_SList *l)
 {
     SCE_SListIterator *it = l->last.prev;
-    SCE_List_Removel (it);
+    SCE_List_IndexDel (l, it);
+    SCE_List_Unlinkl (it);
+    SCE_List_AddLength (l, -1);
     return it;
 }
 
@@ -475,13 +827,13 @@ SCE_SListIterator* SCE_List_RemoveLast (SCE_SList *l)
  */
 void SCE_List_Erase (SCE_SList *l, SCE_SListIterator *it)
 {
-    SCE_List_Remove (it);
+    SCE_List_Detach (l, it);
     if (l->f)
         l->f (it->data);
     else if (l->f2)
         l->f2 (l->f2arg, it->data);
     if (l->canfree)
-        SCE_List_DeleteIt (it);
+        SCE_List_FreeIt (l, it);
 }
 /**
  * \brief Fully remove the first element of a list
@@ -540,7 +892,7 @@ void SCE_List_RemoveFromData (SCE_SList *l, void *data)
 {
     SCE_SListIterator *it = SCE_List_LocateIterator (l, data, NULL);
     if (it)
-        SCE_List_Removel (it);
+        SCE_List_Detach (l, it);
 }
 
 /**
@@ -567,6 +919,8 @@ void SCE_List_EraseFromData (SCE_SList *l, void *data)
  */
 void SCE_List_Join (SCE_SList *l1, SCE_SList *l2)
 {
+    SCE_List_SetDirty (l1);
+    SCE_List_SetDirty (l2);
     l2->first.prev = &l1->last;
     l2->first.next->prev = l1->last.prev;
 
@@ -610,8 +964,11 @@ static void SCE_List_InitLast (SCE_SListIterator *it)
  */
 void SCE_List_BreakStart (SCE_SList *l)
 {
-    if (l->first.prev)
+    SCE_List_SetDirty (l);
+    if (l->first.prev) {
+        SCE_List_SetDirty (l->first.prev->data);
         SCE_List_InitLast (l->first.prev);
+    }
     SCE_List_InitFirst (&l->first);
 }
 /**
@@ -620,8 +977,11 @@ void SCE_List_BreakStart (SCE_SList *l)
  */
 void SCE_List_BreakEnd (SCE_SList *l)
 {
-    if (l->last.next)
+    SCE_List_SetDirty (l);
+    if (l->last.next) {
+        SCE_List_SetDirty (l->last.next->data);
         SCE_List_InitFirst (l->last.next);
+    }
     SCE_List_InitLast (&l->last);
 }
 
@@ -658,6 +1018,11 @@ void SCE_List_Extract (SCE_SList *l)
     SCE_SListIterator *prv, *nxt;
     prv = l->first.prev;
     nxt = l->last.next;
+    SCE_List_SetDirty (l);
+    if (prv)
+        SCE_List_SetDirty (prv->data);
+    if (nxt)
+        SCE_List_SetDirty (nxt->data);
     if (prv) {
         if (!nxt)
             SCE_List_InitLast (prv);
@@ -681,11 +1046,35 @@ void SCE_List_Extract (SCE_SList *l)
  * \param it the SCE_SListIterator where set the data
  * \param data the data to set to the iterator
  * \returns the old data, if any
+ * \note If \p it is attached, the indexes of every list are rebuilt on their
+ * next lookup, SCE_List_SetDatal() updates the index of its list instead.
+ * \sa SCE_List_SetDatal(), SCE_List_EnableIndex()
  */
 void* SCE_List_SetData (SCE_SListIterator *it, void *data)
 {
     void *old = it->data;
     it->data = data;
+    if (it->prev || it->next)
+        SCE_List_Touch ();      /* indexes are keyed by data */
+    return old;
+}
+/**
+ * \brief Sets data of an element of a given list
+ * \param l the list \p it belongs to
+ * \param it an element of \p l
+ * \param data the data to set to the iterator
+ * \returns the old data, if any
+ *
+ * Same as SCE_List_SetData(), but updates the index of \p l instead of
+ * invalidating it.
+ * \sa SCE_List_SetData(), SCE_List_EnableIndex()
+ */
+void* SCE_List_SetDatal (SCE_SList *l, SCE_SListIterator *it, void *data)
+{
+    void *old = it->data;
+    SCE_List_IndexDel (l, it);
+    it->data = data;
+    SCE_List_IndexAdd (l, it);
     return old;
 }
 #if 0
@@ -701,16 +1090,33 @@ void* SCE_List_GetData (SCE_SListIterator *it)
 #endif
 
 /**
- * \brief Gets the length of a SCE_SList
- * \param l a SCE_SList
- * \returns the length of the list pointed by \p l
+ * \brief Gets the number of elements of a list
+ * \param l a list
+ * \returns the number of elements of \p l, and of the lists joined after it
+ *
+ * The length is cached and kept up to date by the functions taking \p l as
+ * argument, like SCE_List_Appendl(), SCE_List_Detach() or SCE_List_Erase(),
+ * this is then O(1). The functions working on bare iterators
+ * (SCE_List_Attach(), SCE_List_Append(), SCE_List_Remove(),
+ * SCE_List_Removel(), SCE_List_AppendNew()...) cannot tell which list they
+ * modify: they invalidate the cached length of every list, which is
+ * recomputed on its next query. Lengths of joined lists are not cached.
  */
 unsigned int SCE_List_GetLength (const SCE_SList *l)
 {
+    unsigned long long epoch = SCE_List_GetEpoch ();
     unsigned int n = 0;
     SCE_SListIterator *it;
+
+    if (l->epoch == epoch && !SCE_List_IsJoined (l))
+        return l->length;
     SCE_List_ForEach (it, l)
         n++;
+    if (!SCE_List_IsJoined (l)) {
+        /* the cache is not part of the value of the list */
+        ((SCE_SList*)l)->length = n;
+        ((SCE_SList*)l)->epoch = epoch;
+    }
     return n;
 }
 
@@ -825,6 +1231,9 @@ SCE_SListIterator* SCE_List_LocateIterator (const SCE_SList *l, void *data,
                                             SCE_FListCompareData f)
 {
     SCE_SListIterator *i = NULL;
+    /* the index is not part of the value of the list */
+    if (!f && SCE_List_IndexUpdate ((SCE_SList*)l))
+        return SCE_List_IndexLookup (l, data);
     SCE_List_ForEach (i, l) {
         if ((f && f (data, i->data)) || data == i->data)
             return i;
@@ -839,6 +1248,7 @@ SCE_SListIterator* SCE_List_LocateIterator (const SCE_SList *l, void *data,
  * \param f a function to compares \p data to each list's data, or NULL for a
  * pointer comparison
  * \returns the founded iterator's index, or 0 if index can't be found
+ * \note This is O(n) even if \p l has an index, see SCE_List_EnableIndex().
  * \sa SCE_List_LocateIterator()
  */
 unsigned int SCE_List_LocateIndex (const SCE_SList *l, void *data,
@@ -846,6 +1256,10 @@ unsigned int SCE_List_LocateIndex (const SCE_SList *l, void *data,
 {
     unsigned int j = 0;
     SCE_SListIterator *i = NULL;
+    if (!f && SCE_List_IndexUpdate ((SCE_SList*)l)) {
+        i = SCE_List_IndexLookup (l, data);
+        return i ? SCE_List_GetIndex (i) : 0;
+    }
     SCE_List_ForEach (i, l) {
         if ((f && f (data, i->data)) || data == i->data)
             return j;
@@ -960,10 +1374,10 @@ void SCE_List_Swapl (SCE_SListIterator *a, SCE_SListIterator *b)
         SCE_SListIterator *prev_a = a->prev;
         SCE_SListIterator *prev_b = b->prev;
 
-        SCE_List_Removel (a);
-        SCE_List_Removel (b);
-        SCE_List_Append (prev_a, b);
-        SCE_List_Append (prev_b, a);
+        SCE_List_Unlinkl (a);
+        SCE_List_Unlinkl (b);
+        SCE_List_LinkAfter (prev_a, b);
+        SCE_List_LinkAfter (prev_b, a);
     }
 }
 
@@ -994,17 +1408,17 @@ void SCE_List_Swap (SCE_SListIterator *a, SCE_SListIterator *b)
         SCE_SListIterator *prev_b = b->prev;
         SCE_SListIterator *next_b = b->next;
 
-        SCE_List_Remove (a);
-        SCE_List_Remove (b);
+        SCE_List_Unlink (a);
+        SCE_List_Unlink (b);
         if (prev_a) {
-            SCE_List_Append (prev_a, b);
+            SCE_List_LinkAfter (prev_a, b);
         } else {
-            SCE_List_Prepend (b, next_a);
+            SCE_List_LinkBefore (b, next_a);
         }
         if (prev_b) {
-            SCE_List_Append (prev_b, a);
+            SCE_List_LinkAfter (prev_b, a);
         } else {
-            SCE_List_Prepend (a, next_b);
+            SCE_List_LinkBefore (a, next_b);
         }
     }
 }
@@ -1043,4 +1457,77 @@ void SCE_List_GnomeSort (SCE_SList *l, SCE_FListCompareData func)
     }
 }
 
+/* merges two sorted chains linked through their next pointers, the
+   elements of \p a come first on equality */
+static SCE_SListIterator* SCE_List_Merge (SCE_SListIterator *a,
+                                          SCE_SListIterator *b,
+                                          SCE_FListCompareData func)
+{
+    SCE_SListIterator head;
+    SCE_SListIterator *tail = &head;
+
+    while (a && b) {
+        if (func (a->data, b->data) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+    return head.next;
+}
+
+/**
+ * @brief Sorts a list
+ * @param l a list
+ * @param func a function used to compare two elements of the list
+ *
+ * This function sorts a list using a bottom-up merge sort in O(n log n). The
+ * sort is stable: elements comparing equal keep their order. The iterators
+ * are relinked in place, their data is not moved and nothing is allocated.
+ * \sa SCE_List_Sort()
+ */
+void SCE_List_MergeSort (SCE_SList *l, SCE_FListCompareData func)
+{
+    /* bins[i] is a sorted chain of 2^i elements, or NULL */
+    SCE_SListIterator *bins[sizeof (size_t) * 8];
+    SCE_SListIterator *it = NULL, *next = NULL, *carry = NULL;
+    size_t i, n_bins = 0;
+
+    if (l->first.next == &l->last || l->first.next->next == &l->last)
+        return;
+
+    for (it = l->first.next; it != &l->last; it = next) {
+        next = it->next;
+        it->next = NULL;
+        carry = it;
+        for (i = 0; i < n_bins && bins[i]; i++) {
+            /* bins[i] holds older elements, keep them first */
+            carry = SCE_List_Merge (bins[i], carry, func);
+            bins[i] = NULL;
+        }
+        if (i == n_bins)
+            n_bins++;
+        bins[i] = carry;
+    }
+    carry = NULL;
+    for (i = 0; i < n_bins; i++) {
+        if (bins[i])
+            carry = SCE_List_Merge (bins[i], carry, func);
+    }
+
+    /* restore the prev pointers */
+    it = &l->first;
+    for (; carry; carry = carry->next) {
+        it->next = carry;
+        carry->prev = it;
+        it = carry;
+    }
+    it->next = &l->last;
+    l->last.prev = it;
+}
+
 /** @} */
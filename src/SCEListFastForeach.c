@@ -17,11 +17,14 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 26/01/2009
-   updated: 10/04/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 
 #include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEWorkers.h"
 #include "SCE/utils/SCEListFastForeach.h"
 
 #define SCE_NUM_SIZES 9
@@ -275,3 +278,243 @@ void SCE_List_FastForEach4 (SCE_SList *l, unsigned int size,
             it = fastfuncs4[i] (it, f);
     }
 }
+
+
+/* moves \p it \p n elements forward, stops at the end of the list */
+static SCE_SListIterator* SCE_List_Advance (SCE_SListIterator *it,
+                                            unsigned int n)
+{
+    for (; n > 0 && it->next; n--)
+    {
+        SCE_PREFETCH (it->next);
+        it = it->next;
+    }
+    return it;
+}
+
+/**
+ * \brief Calls a function on the data of each element of a list, loading
+ * the elements ahead of time
+ * \param l a list
+ * \param distance number of elements to load ahead of the one being
+ * processed
+ * \param f function called on the data of each element
+ * \param param user data given to \p f
+ *
+ * While \p f runs on an element, the iterator and the data of the element
+ * \p distance positions further are requested to the memory, which hides
+ * the latency of lists whose iterators or data are scattered in memory. A
+ * good distance is about the number of elements processed during one
+ * memory access, usually between 4 and 16.
+ * \sa SCE_List_FastForEach2(), SCE_List_BatchForEach()
+ */
+void SCE_List_PrefetchForEach2 (SCE_SList *l, unsigned int distance,
+                                SCE_FListFastForeach2 f, void *param)
+{
+    SCE_SListIterator *it = SCE_List_GetFirst (l);
+    SCE_SListIterator *ahead = SCE_List_Advance (it, distance);
+
+    for (; it->next; it = it->next)
+    {
+        if (ahead->next)
+        {
+            SCE_PREFETCH (ahead->data);
+            ahead = ahead->next;
+            SCE_PREFETCH (ahead);
+        }
+        f (it->data, param);
+    }
+}
+
+/**
+ * \brief Calls a function on arrays of data of the elements of a list
+ * \param l a list
+ * \param batch maximum number of elements given to one call of \p f, up
+ * to SCE_LIST_MAX_BATCH
+ * \param distance number of elements to load ahead, see
+ * SCE_List_PrefetchForEach2()
+ * \param f function receiving an array of data, its length and \p param
+ * \param param user data given to \p f
+ *
+ * The data of the elements are gathered in order into an array and given to
+ * \p f, letting it process them with a tight loop that the compiler can
+ * vectorize. Every call but the last one receives \p batch elements.
+ * \sa SCE_List_PrefetchForEach2()
+ */
+void SCE_List_BatchForEach (SCE_SList *l, unsigned int batch,
+                            unsigned int distance, SCE_FListBatchForeach f,
+                            void *param)
+{
+    void *data[SCE_LIST_MAX_BATCH];
+    SCE_SListIterator *it = SCE_List_GetFirst (l);
+    SCE_SListIterator *ahead = SCE_List_Advance (it, distance);
+    unsigned int n = 0;
+
+    if (batch < 1)
+        batch = 1;
+    else if (batch > SCE_LIST_MAX_BATCH)
+        batch = SCE_LIST_MAX_BATCH;
+
+    for (; it->next; it = it->next)
+    {
+        if (ahead->next)
+        {
+            SCE_PREFETCH (ahead->data);
+            ahead = ahead->next;
+            SCE_PREFETCH (ahead);
+        }
+        data[n++] = it->data;
+        if (n == batch)
+        {
+            f (data, n, param);
+            n = 0;
+        }
+    }
+    if (n)
+        f (data, n, param);
+}
+
+/* maximum number of ranges per thread, more ranges balance better the load
+   when the callback does not take the same time for every element */
+#define SCE_LIST_RANGES_PER_THREAD 4
+
+typedef struct sce_slistparallel SCE_SListParallel;
+struct sce_slistparallel
+{
+    SCE_SListIterator **starts; /* first iterator of each range */
+    unsigned int size;          /* number of elements */
+    unsigned int n_ranges;
+    SCE_FListFastForeach f;
+    SCE_FListFastForeach2 f2;
+    SCE_FListFastForeach3 f3;
+    SCE_FListFastForeach4 f4;
+    void *param;
+};
+
+static unsigned int SCE_List_GetRangeSize (const SCE_SListParallel *p,
+                                           unsigned int i)
+{
+    return p->size / p->n_ranges + (i < p->size % p->n_ranges);
+}
+
+static void SCE_List_ParallelRange (unsigned int i, void *data)
+{
+    SCE_SListParallel *p = data;
+    SCE_SListIterator *it = p->starts[i];
+    unsigned int j, n = SCE_List_GetRangeSize (p, i);
+
+    if (p->f)
+        for (j = 0; j < n; j++, it = it->next)
+            p->f (it, p->param);
+    else if (p->f2)
+        for (j = 0; j < n; j++, it = it->next)
+            p->f2 (it->data, p->param);
+    else if (p->f3)
+        for (j = 0; j < n; j++, it = it->next)
+            p->f3 (it);
+    else
+        for (j = 0; j < n; j++, it = it->next)
+            p->f4 (it->data);
+}
+
+/* splits the \p size first elements of \p l into balanced ranges of at
+   least \p grain elements and runs them on the worker threads */
+static void SCE_List_Parallel (SCE_SList *l, unsigned int size,
+                               unsigned int grain, SCE_SListParallel *p)
+{
+    SCE_SListIterator *first = SCE_List_GetFirst (l);
+    SCE_SListIterator *it = NULL;
+    unsigned int i, j, max_ranges;
+
+    if (!size)
+        return;
+    if (grain < 1)
+        grain = 1;
+    max_ranges = SCE_Workers_GetCount () * SCE_LIST_RANGES_PER_THREAD;
+    p->size = size;
+    p->n_ranges = size / grain + (size % grain != 0);
+    if (p->n_ranges > max_ranges)
+        p->n_ranges = max_ranges;
+    p->starts = &first;
+
+    if (p->n_ranges > 1 &&
+        !(p->starts = SCE_malloc (p->n_ranges * sizeof *p->starts)))
+    {
+        /* not fatal, fall back to a single range */
+        SCEE_Clear ();
+        p->starts = &first;
+        p->n_ranges = 1;
+    }
+    if (p->n_ranges == 1)
+    {
+        SCE_List_ParallelRange (0, p);
+        return;
+    }
+
+    it = first;
+    for (i = 0; i < p->n_ranges; i++)
+    {
+        p->starts[i] = it;
+        for (j = SCE_List_GetRangeSize (p, i); j > 0; j--)
+            it = it->next;
+    }
+    SCE_Workers_Run (p->n_ranges, SCE_List_ParallelRange, p);
+    SCE_free (p->starts);
+}
+
+/**
+ * \brief Calls a function on each element of a list from the worker threads
+ * \param l a list
+ * \param size number of elements of \p l to process
+ * \param grain minimum number of elements processed by a single task
+ * \param f function called on each element
+ * \param param user data given to \p f
+ *
+ * The \p size first elements of \p l are split into balanced ranges of at
+ * least \p grain elements which are processed concurrently by the worker
+ * threads and the calling thread. The function returns once every element
+ * has been processed. \p f must not modify the list.
+ * \sa SCE_List_FastForEach(), SCE_Workers_Run()
+ */
+void SCE_List_ParallelForEach (SCE_SList *l, unsigned int size,
+                               unsigned int grain, SCE_FListFastForeach f,
+                               void *param)
+{
+    SCE_SListParallel p = {0};
+    p.f = f;
+    p.param = param;
+    SCE_List_Parallel (l, size, grain, &p);
+}
+/**
+ * \brief Same as SCE_List_ParallelForEach() but \p f receives the data of
+ * the elements
+ */
+void SCE_List_ParallelForEach2 (SCE_SList *l, unsigned int size,
+                                unsigned int grain, SCE_FListFastForeach2 f,
+                                void *param)
+{
+    SCE_SListParallel p = {0};
+    p.f2 = f;
+    p.param = param;
+    SCE_List_Parallel (l, size, grain, &p);
+}
+/**
+ * \brief Same as SCE_List_ParallelForEach() without user data
+ */
+void SCE_List_ParallelForEach3 (SCE_SList *l, unsigned int size,
+                                unsigned int grain, SCE_FListFastForeach3 f)
+{
+    SCE_SListParallel p = {0};
+    p.f3 = f;
+    SCE_List_Parallel (l, size, grain, &p);
+}
+/**
+ * \brief Same as SCE_List_ParallelForEach2() without user data
+ */
+void SCE_List_ParallelForEach4 (SCE_SList *l, unsigned int size,
+                                unsigned int grain, SCE_FListFastForeach4 f)
+{
+    SCE_SListParallel p = {0};
+    p.f4 = f;
+    SCE_List_Parallel (l, size, grain, &p);
+}
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 05/01/2007
-   updated: 25/06/2011 */
+   updated: 18/10/2026 */
 
 #include <stdio.h>
 #include <errno.h>
@@ -26,6 +26,7 @@
 #include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEString.h"
 #include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEJobs.h"
 #include "SCE/utils/SCEMedia.h"
 
 
@@ -77,7 +78,7 @@ static void SCE_Media_InitType (SCE_SMediaType *type)
 static SCE_SMediaType* SCE_Media_CreateType (void)
 {
     SCE_SMediaType *type = NULL;
-    if (!(type = SCE_malloc (sizeof *type))) {
+    if (!(type = SCE_malloc_tagged (SCE_MEM_TAG_MEDIA, sizeof *type))) {
         SCEE_LogSrc ();
         return NULL;
     }
@@ -255,6 +256,68 @@ void* SCE_Media_Load (int type, const char *fname, void *param)
     return media;
 }
 
+typedef struct sce_smedialoading SCE_SMediaLoading;
+struct sce_smedialoading {
+    int type;
+    const char **fnames;
+    void **medias;
+    void *param;
+    unsigned int n_failed;
+};
+
+static void SCE_Media_LoadRange (size_t begin, size_t end, void *data)
+{
+    SCE_SMediaLoading *l = data;
+
+    for (; begin < end; begin++) {
+        l->medias[begin] = SCE_Media_Load (l->type, l->fnames[begin],
+                                           l->param);
+        if (!l->medias[begin]) {
+            __atomic_add_fetch (&l->n_failed, 1, __ATOMIC_RELAXED);
+            /* each thread has its own error log, the caller would never
+               see this one */
+            SCEE_Out ();
+            SCEE_Clear ();
+        }
+    }
+}
+
+/**
+ * \brief Loads several files at once on the job system
+ * \param type type of the medias
+ * \param fnames names of the files
+ * \param medias receives the loaded medias, NULL for the files that failed
+ * to load
+ * \param n number of files
+ * \param param parameter given to the loading functions
+ * \returns SCE_OK if every file was loaded, SCE_ERROR otherwise
+ *
+ * The loading functions and the path parsing function (see
+ * SCE_Media_SetParsePathFunc()) are called from several threads at once
+ * and must be thread safe. The errors of each file are printed as they
+ * happen.
+ * \sa SCE_Media_Load(), SCE_Jobs_ParallelFor()
+ */
+int SCE_Media_LoadMany (int type, const char **fnames, void **medias,
+                        size_t n, void *param)
+{
+    SCE_SMediaLoading l;
+
+    l.type = type;
+    l.fnames = fnames;
+    l.medias = medias;
+    l.param = param;
+    l.n_failed = 0;
+    SCE_Jobs_ParallelFor (0, n, 1, SCE_Media_LoadRange, &l);
+    if (l.n_failed) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("%u of %lu files failed to load", l.n_failed,
+                     (unsigned long)n);
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
 
 int SCE_Media_Save (int type, void *data, const char *fname)
 {
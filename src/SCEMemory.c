@@ -17,11 +17,15 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 22/12/2006
-   updated: 14/05/2010 */
+   updated: 18/10/2026 */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
@@ -38,17 +42,137 @@
 
 /**
  * \defgroup memory Memory managment
- * Wrapper around libc functions for memory managment
+ * Memory allocator of the SCEngine
  * \ingroup utils
+ *
+ * Blocks up to SCE_MEM_MAX_SMALL bytes are served by size classes: each
+ * thread keeps a free list per class and refills it by batches from a
+ * shared pool of slabs, so that most small allocations never take a lock.
+ * Bigger blocks are forwarded to the libc. In debug builds every block is
+ * also recorded along with the location of its allocation.
  */
 
 /** @{ */
 
+#ifdef SCE_DEBUG
 #define SCE_USE_MEMORY_MANAGER 1
+#else
+#define SCE_USE_MEMORY_MANAGER 0
+#endif
+
+/* alignment of the blocks returned to the user */
+#define SCE_MEM_ALIGN 16
+/* size reserved in front of each block, must be a multiple of SCE_MEM_ALIGN */
+#define SCE_MEM_HEADER_SIZE 16
+/* number of size classes, class i serves blocks of (i + 1) * SCE_MEM_ALIGN */
+#define SCE_NUM_MEMORY_ARRAYS 16
+/* biggest size served by the size classes, bigger blocks go to the system */
+#define SCE_MEM_MAX_SMALL (SCE_NUM_MEMORY_ARRAYS * SCE_MEM_ALIGN)
+/* size in bytes of the slabs carved by the size classes */
+#define SCE_ARRAY_BLOCK_SIZE 65536
+
+/**
+ * \brief Header stored right before every block returned by the allocator
+ */
+typedef struct SCE_SMemHeader {
+    size_t size;                /* size requested by the user */
+    unsigned char sclass;       /* size class + 1, or 0 for system blocks */
+    unsigned char flags;        /* SCE_MEM_* flags below */
+    unsigned char align;        /* log2 of the alignment of aligned blocks */
+    unsigned char tag;          /* memory tag, see SCE_Mem_AllocTagged() */
+    unsigned int offset;        /* distance from the system block to the
+                                   user block for aligned blocks */
+} SCE_SMemHeader;
+
+/* the block is preceded by a SCE_SMemSample, see SCE_Mem_SetSampleRate() */
+#define SCE_MEM_SAMPLED 1
+/* the block was over-allocated to honor an alignment, see \c offset */
+#define SCE_MEM_ALIGNED 2
+
+#define SCE_Mem_GetHeader(p)\
+    ((SCE_SMemHeader*)((unsigned char*)(p) - SCE_MEM_HEADER_SIZE))
+#define SCE_Mem_GetHeaderAddress(h)\
+    ((void*)((unsigned char*)(h) + SCE_MEM_HEADER_SIZE))
+
+/* a free slot of a size class, linked through its header */
+typedef struct SCE_SMemSlot {
+    struct SCE_SMemSlot *next;
+} SCE_SMemSlot;
+
+/* a slab, its slots follow the first SCE_MEM_ALIGN bytes */
+typedef struct SCE_SMemArrayBlock {
+    struct SCE_SMemArrayBlock *next;
+} SCE_SMemArrayBlock;
+
+/* shared pool of a size class, feeding the thread caches */
+typedef struct SCE_SMemArray {
+    size_t alloc_size;         /* size of one slot, header included */
+    unsigned int batch;        /* slots moved at once from/to a cache */
+    SCE_SMemSlot *free;        /* free slots */
+    SCE_SMemArrayBlock *root;  /* slabs, never given back to the system */
+    pthread_mutex_t mutex;
+} SCE_SMemArray;
 
-#define SCE_NUM_MEMORY_ARRAYS 128
-/* number of allocs per block */
-#define SCE_ARRAY_BLOCK_SIZE 128
+/* per-thread free lists, one for each size class */
+typedef struct SCE_SMemCache {
+    SCE_SMemSlot *free[SCE_NUM_MEMORY_ARRAYS];
+    unsigned int nfree[SCE_NUM_MEMORY_ARRAYS];
+} SCE_SMemCache;
+
+/**
+ * \brief Record in front of the header of a sampled block
+ */
+typedef struct SCE_SMemSample {
+    SCE_SMemSite *site;         /* callsite the sample was accounted to */
+    size_t bytes;               /* bytes the sample stands for */
+} SCE_SMemSample;
+
+/* size of a sample record, rounded to keep the user blocks aligned */
+#define SCE_MEM_SAMPLE_SIZE\
+    ((sizeof (SCE_SMemSample) + SCE_MEM_ALIGN - 1) & ~(SCE_MEM_ALIGN - 1))
+/* bytes allocated between two reads of sample_rate while sampling is off */
+#define SCE_MEM_SAMPLE_RECHECK (1 << 20)
+
+/**
+ * \brief Counters and budgets of a memory tag
+ */
+typedef struct SCE_SMemTag {
+    const char *name;
+    long live;                  /* updated atomically */
+    long peak;                  /* updated atomically */
+    size_t n_allocs;            /* updated atomically */
+    size_t n_frees;             /* updated atomically */
+    size_t soft, hard;          /* budgets, 0 means unlimited */
+    SCE_FMemBudgetFunc func;    /* called when a budget is exceeded */
+    void *data;                 /* user data of \c func */
+} SCE_SMemTag;
+
+static SCE_SMemTag tags[SCE_MEM_NUM_TAGS] = {
+    {"none", 0, 0, 0, 0, 0, 0, NULL, NULL},
+    {"resource", 0, 0, 0, 0, 0, 0, NULL, NULL},
+    {"media", 0, 0, 0, 0, 0, 0, NULL, NULL},
+    {"math", 0, 0, 0, 0, 0, 0, NULL, NULL}
+};
+
+/* allocator installed by SCE_Mem_SetAllocator(), NULL for the C library */
+static SCE_SMemAllocator backend_s;
+static const SCE_SMemAllocator *backend = NULL;
+
+static SCE_SMemArray arrays[SCE_NUM_MEMORY_ARRAYS];
+static pthread_once_t arrays_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+/* read on every allocation: the initial-exec model spares a call to
+   __tls_get_addr() when the library is a shared object */
+#define SCE_MEM_TLS __thread __attribute__ ((tls_model ("initial-exec")))
+static SCE_MEM_TLS SCE_SMemCache *cache = NULL;
+
+/* average number of bytes between two samples, 0 to disable sampling */
+static size_t sample_rate = 0;
+#if !SCE_USE_MEMORY_MANAGER
+/* bytes left to allocate by the thread before taking the next sample */
+static SCE_MEM_TLS long sample_countdown = 0;
+static SCE_MEM_TLS unsigned int sample_seed = 0;
+#endif
 
 /**
  * \brief Stores metadata about memory blocks
@@ -59,262 +183,529 @@ typedef struct SCE_SMemAlloc {
     const char *file;
     unsigned int line;
     size_t size;
-    void *block; /* hack */
-    struct SCE_SMemAlloc *next, *prev;
+    void *block;                /* block holding the descriptor */
+    unsigned int tag;           /* memory tag, see SCE_Mem_AllocTagged() */
+    SCE_SMemSite *site;         /* statistics of the callsite */
+    struct SCE_SMemAlloc *next; /* next descriptor in the same bucket */
 } SCE_SMemAlloc;
 
+/* size of a descriptor, rounded to keep the user blocks aligned */
+#define SCE_MEM_ALLOC_SIZE\
+    ((sizeof (SCE_SMemAlloc) + SCE_MEM_ALIGN - 1) & ~(SCE_MEM_ALIGN - 1))
+
+/* number of shards of the allocations table, must be a power of two */
+#define SCE_MEM_NUM_SHARDS 64
+/* initial number of buckets of a shard, must be a power of two */
+#define SCE_MEM_SHARD_BUCKETS 64
+
+/**
+ * \brief A shard of the allocations table
+ *
+ * The descriptors are hashed by address, each shard has its own lock so that
+ * threads freeing unrelated blocks do not wait for each other.
+ */
+typedef struct SCE_SMemShard {
+    SCE_SMemAlloc **buckets;
+    size_t n_buckets;           /* always a power of two */
+    size_t n_allocs;
+    pthread_mutex_t mutex;
+} SCE_SMemShard;
+
 /** \brief Table of all allocations */
-static SCE_SMemAlloc allocs = {
-    "root allocations list", 0, 0, NULL, NULL, NULL
-};
-static pthread_mutex_t allocs_m;
-static pthread_mutexattr_t allocs_mattr;
+static SCE_SMemShard shards[SCE_MEM_NUM_SHARDS];
+static pthread_once_t shards_once = PTHREAD_ONCE_INIT;
 
+/* number of buckets of the callsites table, must be a power of two */
+#define SCE_MEM_SITE_BUCKETS 1024
 
-typedef struct SCE_SMemArrayBlock {
-    SCE_SMemAlloc *allocs[SCE_ARRAY_BLOCK_SIZE];
-    SCE_SMemAlloc *freeallocs[SCE_ARRAY_BLOCK_SIZE];
-    int nfree;         /* number of free allocs in 'allocs' */
-    struct SCE_SMemArrayBlock *next, *prev;
-} SCE_SMemArrayBlock;
+typedef struct SCE_SMemSiteEntry {
+    SCE_SMemSite site;          /* must be first */
+    struct SCE_SMemSiteEntry *next;
+} SCE_SMemSiteEntry;
 
-/* structure d'un tableau contenant une suite d'allocations de la meme taille */
-typedef struct SCE_SMemArray {
-    size_t alloc_size;         /* size of one allocation */
-    SCE_SMemArrayBlock *root;  /* root block */
-    SCE_SMemArrayBlock *last;  /* last block */
-} SCE_SMemArray;
+/** \brief Statistics of every callsite, never shrinks */
+static SCE_SMemSiteEntry *sites[SCE_MEM_SITE_BUCKETS];
+/* bucket i is protected by sites_m[i % SCE_MEM_NUM_SHARDS] */
+static pthread_mutex_t sites_m[SCE_MEM_NUM_SHARDS];
 
-static SCE_SMemArray arrays[SCE_NUM_MEMORY_ARRAYS];
-static pthread_mutex_t arrays_m = PTHREAD_MUTEX_INITIALIZER;
 
-#define SCE_Mem_For(i) for ((i) = allocs.next; (i); (i) = (i)->next)
+static void SCE_Mem_DeleteCache (void*);
+static void SCE_Mem_DeleteSampledBlock (SCE_SMemHeader*);
 
-static void SCE_Mem_InitArray (SCE_SMemArray *a)
+static void SCE_Mem_InitArrays (void)
 {
-    a->alloc_size = 1; /* hop */
-    a->root = NULL;
-    a->last = NULL;
+    size_t i;
+    for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++) {
+        SCE_SMemArray *a = &arrays[i];
+        a->alloc_size = SCE_MEM_HEADER_SIZE + (i + 1) * SCE_MEM_ALIGN;
+        a->batch = 4096 / a->alloc_size;
+        if (a->batch < 8)
+            a->batch = 8;
+        else if (a->batch > 64)
+            a->batch = 64;
+        a->free = NULL;
+        a->root = NULL;
+        pthread_mutex_init (&a->mutex, NULL);
+    }
+    pthread_key_create (&cache_key, SCE_Mem_DeleteCache);
 }
 
-int SCE_Init_Mem (void)
+static void SCE_Mem_InitShards (void)
 {
     size_t i;
-    for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++) {
-        SCE_Mem_InitArray (&arrays[i]);
-        arrays[i].alloc_size = i + 1;
+    for (i = 0; i < SCE_MEM_NUM_SHARDS; i++) {
+        shards[i].buckets = NULL;
+        shards[i].n_buckets = 0;
+        shards[i].n_allocs = 0;
+        pthread_mutex_init (&shards[i].mutex, NULL);
+        pthread_mutex_init (&sites_m[i], NULL);
     }
+    for (i = 0; i < SCE_MEM_SITE_BUCKETS; i++)
+        sites[i] = NULL;
+}
 
-#if 0
-    /* lol pthread_mutex_recursive is not defined. */
-    pthread_mutexattr_init (&allocs_mattr);
-    pthread_mutexattr_settype (&allocs_mattr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init (&allocs_m, &allocs_mattr);
-#else
-    pthread_mutex_init (&allocs_m, NULL);
-#endif
-
+int SCE_Init_Mem (void)
+{
+    pthread_once (&arrays_once, SCE_Mem_InitArrays);
+    pthread_once (&shards_once, SCE_Mem_InitShards);
     return SCE_OK;
 }
 void SCE_Quit_Mem (void)
 {
-    /* tell the user: be sure the mutexes are unlocked */
-    pthread_mutex_destroy (&allocs_m);
-    pthread_mutex_destroy (&arrays_m);
-    /* safe further re-init, keep the data in the state we got them
-       at initialization */
-    pthread_mutex_init (&allocs_m, NULL);
-    pthread_mutex_init (&arrays_m, NULL);
+    /* the size classes and the allocations table stay alive: blocks can
+       still be freed after this and other threads may keep caches */
 }
 
-static void SCE_Mem_InitAlloc (SCE_SMemAlloc *m)
+/**
+ * \brief Routes the allocations of the library to another allocator
+ * \param a the allocator to use, NULL to go back to the C library
+ * \returns SCE_OK on success, SCE_ERROR if \p a is incomplete
+ *
+ * Every block allocated by SCEngine ends up in \p a, including the slabs of
+ * the size classes and the bookkeeping of the memory manager; only the
+ * regions (see SCE_Mem_ReserveRegion()) keep using the system directly.
+ * SCE_SMemAllocator::calloc is optional, and so are \c alloc_aligned and
+ * \c free_aligned which must be given together. \p a is copied.
+ *
+ * Call this before the first allocation, the blocks allocated so far would
+ * be given to the wrong allocator: SCE_Init_Utils2() does that for you.
+ * \sa SCE_Init_Utils2()
+ */
+int SCE_Mem_SetAllocator (const SCE_SMemAllocator *a)
 {
-    m->file = NULL;
-    m->line = 1;
-    m->size = 0;
-    m->block = NULL;
-    m->next = m->prev = NULL;
+    if (!a) {
+        backend = NULL;
+        return SCE_OK;
+    }
+    if (!a->alloc || !a->realloc || !a->free ||
+        !a->alloc_aligned != !a->free_aligned) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("incomplete allocator: alloc, realloc and free are "
+                     "required, alloc_aligned and free_aligned go together");
+        return SCE_ERROR;
+    }
+    backend_s = *a;
+    backend = &backend_s;
+    return SCE_OK;
+}
+/**
+ * \brief Gets the allocator set by SCE_Mem_SetAllocator()
+ * \returns the allocator in use, NULL for the C library
+ */
+const SCE_SMemAllocator* SCE_Mem_GetAllocator (void)
+{
+    return backend;
 }
 
-static void SCE_Mem_InitBlock (SCE_SMemArrayBlock *b)
+static unsigned int SCE_Mem_GetArrayIndex (size_t size)
 {
-    unsigned int i;
-    for (i = 0; i < SCE_ARRAY_BLOCK_SIZE; i++) {
-        b->allocs[i] = NULL;
-        b->freeallocs[i] = NULL;
-    }
-    b->nfree = SCE_ARRAY_BLOCK_SIZE;
-    b->next = b->prev = NULL;
+    return (size ? size - 1 : 0) / SCE_MEM_ALIGN;
 }
 
-/* functions managing the arrays */
+/* functions calling the system allocator */
 
-static SCE_SMemArrayBlock* SCE_Mem_CreateBlock (size_t size)
+static void* SCE_Mem_SysAlloc (size_t size)
 {
-    SCE_SMemArrayBlock *b = malloc (sizeof *b);
-    if (!b)
-        SCEE_Log (SCE_OUT_OF_MEMORY);
-    else {
-        size_t i;
-        void *address = NULL;
-        SCE_Mem_InitBlock (b);
-        /* allocate the data */
-        size += sizeof (SCE_SMemAlloc);
-        b->allocs[0] = malloc (size * SCE_ARRAY_BLOCK_SIZE);
-        if (!b->allocs[0]) {
-            SCEE_Log (SCE_OUT_OF_MEMORY);
-            free (b);
+    if (backend)
+        return backend->alloc (backend->data, size);
+    return malloc (size);
+}
+static void* SCE_Mem_SysCalloc (size_t n, size_t size)
+{
+    if (backend) {
+        void *p = NULL;
+        if (backend->calloc)
+            return backend->calloc (backend->data, n, size);
+        if (n && size > (size_t)-1 / n)
             return NULL;
-        }
-        SCE_Mem_InitAlloc (b->allocs[0]);
-        b->allocs[0]->block = b;
-        for (i = 1; i < SCE_ARRAY_BLOCK_SIZE; i++) {
-            address = b->allocs[i-1];
-            address = (void*)((size_t)address + size);
-            b->freeallocs[i] = b->allocs[i] = address;
-            SCE_Mem_InitAlloc (b->allocs[i]);
-            b->allocs[i]->block = b;
-        }
+        if ((p = backend->alloc (backend->data, n * size)))
+            memset (p, 0, n * size);
+        return p;
     }
-    return b;
+    return calloc (n, size);
 }
-
-static void SCE_Mem_DeleteBlock (SCE_SMemArrayBlock *b)
+static void* SCE_Mem_SysRealloc (void *p, size_t size)
 {
-    if (b) {
-        free (b->allocs[0]);
-        free (b);
-    }
+    if (backend)
+        return backend->realloc (backend->data, p, size);
+    return realloc (p, size);
+}
+static void SCE_Mem_SysFree (void *p)
+{
+    if (backend)
+        backend->free (backend->data, p);
+    else
+        free (p);
 }
+/* frees the system block of an aligned block */
+static void SCE_Mem_SysFreeAligned (void *p)
+{
+    if (backend && backend->free_aligned)
+        backend->free_aligned (backend->data, p);
+    else
+        SCE_Mem_SysFree (p);
+}
+
+/* functions managing the size classes */
 
+/* carves a new slab into the free slots of \p a, \p a must be locked */
 static int SCE_Mem_AddNewBlock (SCE_SMemArray *a)
 {
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        if (!a->last) {
-            a->last = a->root = SCE_Mem_CreateBlock (a->alloc_size);
-            if (!a->last)
-                return -1;
-        } else {
-            a->last->next = SCE_Mem_CreateBlock (a->alloc_size);
-            if (!a->last->next)
-                return -1;
-            a->last->next->prev = a->last;
-            a->last = a->last->next;
-        }
-        pthread_mutex_unlock (&arrays_m);
+    SCE_SMemArrayBlock *b = NULL;
+    unsigned char *slot = NULL;
+    size_t i, n;
+
+    if (!(b = SCE_Mem_SysAlloc (SCE_ARRAY_BLOCK_SIZE))) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
     }
-    return 0;
+    b->next = a->root;
+    a->root = b;
+
+    n = (SCE_ARRAY_BLOCK_SIZE - SCE_MEM_ALIGN) / a->alloc_size;
+    slot = (unsigned char*)b + SCE_MEM_ALIGN;
+    for (i = 0; i < n; i++) {
+        ((SCE_SMemSlot*)slot)->next = a->free;
+        a->free = (SCE_SMemSlot*)slot;
+        slot += a->alloc_size;
+    }
+    return SCE_OK;
 }
 
-static void SCE_Mem_EraseBlock (SCE_SMemArray *a, SCE_SMemArrayBlock *b)
+/* moves one batch of free slots from the shared pool into the cache */
+static int SCE_Mem_RefillCache (SCE_SMemCache *c, unsigned int i)
 {
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        if (b->prev)
-            b->prev->next = b->next;
-        else
-            a->root = b->next;
-        if (b->next)
-            b->next->prev = b->prev;
-        else
-            a->last = b->prev;
-        SCE_Mem_DeleteBlock (b);
-        pthread_mutex_unlock (&arrays_m);
+    SCE_SMemArray *a = &arrays[i];
+    SCE_SMemSlot *slot = NULL;
+    unsigned int n = 0;
+
+    pthread_mutex_lock (&a->mutex);
+    if (!a->free && SCE_Mem_AddNewBlock (a) < 0) {
+        pthread_mutex_unlock (&a->mutex);
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    while (a->free && n < a->batch) {
+        slot = a->free;
+        a->free = slot->next;
+        slot->next = c->free[i];
+        c->free[i] = slot;
+        n++;
     }
+    pthread_mutex_unlock (&a->mutex);
+    c->nfree[i] += n;
+    return SCE_OK;
 }
 
-static SCE_SMemAlloc* SCE_Mem_GetNextAllocInBlock (SCE_SMemArrayBlock *b)
+/* gives back \p n free slots of the cache to the shared pool */
+static void SCE_Mem_FlushCache (SCE_SMemCache *c, unsigned int i,
+                                unsigned int n)
 {
-#if 0
-    return (b->nfree ? b->freeallocs[--b->nfree] : NULL);
-#else
-    /* not secure, but this function is (for now) only called if nfree > 0 */
-    return b->freeallocs[--b->nfree];
-#endif
+    SCE_SMemArray *a = &arrays[i];
+    SCE_SMemSlot *first = NULL, *last = NULL;
+    unsigned int j;
+
+    if (!n || !c->free[i])
+        return;
+    first = last = c->free[i];
+    for (j = 1; j < n && last->next; j++)
+        last = last->next;
+    c->free[i] = last->next;
+    c->nfree[i] -= j;
+
+    pthread_mutex_lock (&a->mutex);
+    last->next = a->free;
+    a->free = first;
+    pthread_mutex_unlock (&a->mutex);
 }
 
-static SCE_SMemAlloc* SCE_Mem_GetNextAlloc (SCE_SMemArray *a)
+/* called at thread exit */
+static void SCE_Mem_DeleteCache (void *c)
 {
-    SCE_SMemAlloc *alloc = NULL;
-    SCE_SMemArrayBlock *b = NULL;
-    b = a->last;
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        while (b && !b->nfree)
-            b = b->prev;
-        if (b)
-            alloc = SCE_Mem_GetNextAllocInBlock (b);
-        /* TODO: use recursive mutex */
-        pthread_mutex_unlock (&arrays_m);
+    unsigned int i;
+    for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++)
+        SCE_Mem_FlushCache (c, i, ((SCE_SMemCache*)c)->nfree[i]);
+    SCE_Mem_SysFree (c);
+    cache = NULL;
+}
+
+static SCE_SMemCache* SCE_Mem_GetCache (void)
+{
+    if (!cache) {
+        SCE_SMemCache *c = NULL;
+        pthread_once (&arrays_once, SCE_Mem_InitArrays);
+        if (!(c = SCE_Mem_SysCalloc (1, sizeof *c)))
+            return NULL;
+        pthread_setspecific (cache_key, c);
+        cache = c;
     }
-    return NULL;
+    return cache;
 }
 
-static SCE_SMemAlloc* SCE_Mem_NewAllocFromArray (size_t size)
+/* functions managing the blocks */
+
+/* allocates a block of \p size bytes, from the size classes when possible */
+static void* SCE_Mem_NewBlock (size_t size)
 {
-    SCE_SMemAlloc *m = NULL;
-    /* considers this function is called with a good size */
-    SCE_SMemArray *a = &arrays[size-1];
-    if (!(m = SCE_Mem_GetNextAlloc (a))) {
-        if (!(SCE_Mem_AddNewBlock (a) < 0))
-            m = SCE_Mem_GetNextAlloc (a); /* can't fail */
+    SCE_SMemHeader *h = NULL;
+    SCE_SMemCache *c = NULL;
+
+    if (size <= SCE_MEM_MAX_SMALL && (c = SCE_Mem_GetCache ())) {
+        unsigned int i = SCE_Mem_GetArrayIndex (size);
+        if (!c->free[i] && SCE_Mem_RefillCache (c, i) < 0) {
+            SCEE_LogSrc ();
+            return NULL;
+        }
+        h = (SCE_SMemHeader*)c->free[i];
+        c->free[i] = c->free[i]->next;
+        c->nfree[i]--;
+        h->sclass = i + 1;
+    } else {
+        if (!(h = SCE_Mem_SysAlloc (SCE_MEM_HEADER_SIZE + size))) {
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+            return NULL;
+        }
+        h->sclass = 0;
     }
-    return m;
+    h->size = size;
+    h->flags = 0;
+    h->tag = SCE_MEM_TAG_NONE;
+    return SCE_Mem_GetHeaderAddress (h);
 }
 
-static void SCE_Mem_EraseAllocFromArray (SCE_SMemAlloc *m)
+/* allocates a block of \p size bytes aligned on \p align */
+static void* SCE_Mem_NewAlignedBlock (size_t align, size_t size)
 {
-    SCE_SMemArrayBlock *b = m->block;
-    b->freeallocs[b->nfree++] = m;
-    if (b->nfree >= SCE_ARRAY_BLOCK_SIZE)
-        SCE_Mem_EraseBlock (&arrays[m->size-1], b);
-    SCE_Mem_InitAlloc (m);
+    SCE_SMemHeader *h = NULL;
+    unsigned char *raw = NULL;
+    size_t user;
+    unsigned char log = 0;
+
+    if (align <= SCE_MEM_ALIGN)
+        return SCE_Mem_NewBlock (size);
+    if (backend && backend->alloc_aligned) {
+        /* align is bigger than the header, which fits right before */
+        if (!(raw = backend->alloc_aligned (backend->data, align,
+                                            align + size))) {
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+            return NULL;
+        }
+        user = (size_t)raw + align;
+    } else {
+        raw = SCE_Mem_SysAlloc (SCE_MEM_HEADER_SIZE + align - 1 + size);
+        if (!raw) {
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+            return NULL;
+        }
+        user = ((size_t)raw + SCE_MEM_HEADER_SIZE + align - 1) & ~(align - 1);
+    }
+    while (((size_t)1 << log) < align)
+        log++;
+    h = SCE_Mem_GetHeader (user);
+    h->size = size;
+    h->sclass = 0;
+    h->flags = SCE_MEM_ALIGNED;
+    h->align = log;
+    h->tag = SCE_MEM_TAG_NONE;
+    h->offset = user - (size_t)raw;
+    return (void*)user;
 }
 
-/* functions managing the table of allocations */
+/* gets the alignment \p p was allocated with */
+static size_t SCE_Mem_GetBlockAlign (void *p)
+{
+    SCE_SMemHeader *h = SCE_Mem_GetHeader (p);
+    if (h->flags & SCE_MEM_ALIGNED)
+        return (size_t)1 << h->align;
+    return SCE_MEM_ALIGN;
+}
 
-static SCE_SMemAlloc* SCE_Mem_NewAlloc (size_t size)
+static void SCE_Mem_DeleteBlock (void *p)
 {
-    SCE_SMemAlloc *m = NULL;
-#if 0
-    if (size <= SCE_NUM_MEMORY_ARRAYS)
-        m = SCE_Mem_NewAllocFromArray (size);
+    SCE_SMemHeader *h = SCE_Mem_GetHeader (p);
+
+    if (h->sclass) {
+        unsigned int i = h->sclass - 1;
+        SCE_SMemSlot *slot = (SCE_SMemSlot*)h;
+        SCE_SMemCache *c = SCE_Mem_GetCache ();
+        if (!c) {
+            /* no cache for this thread, go straight to the shared pool */
+            pthread_mutex_lock (&arrays[i].mutex);
+            slot->next = arrays[i].free;
+            arrays[i].free = slot;
+            pthread_mutex_unlock (&arrays[i].mutex);
+        } else {
+            slot->next = c->free[i];
+            c->free[i] = slot;
+            c->nfree[i]++;
+            if (c->nfree[i] > 2 * arrays[i].batch)
+                SCE_Mem_FlushCache (c, i, arrays[i].batch);
+        }
+    } else if (h->flags & SCE_MEM_SAMPLED)
+        SCE_Mem_DeleteSampledBlock (h);
+    else if (h->flags & SCE_MEM_ALIGNED)
+        SCE_Mem_SysFreeAligned ((unsigned char*)p - h->offset);
     else
-#endif
-    {
-        /* make one allocation for all: descriptor and demanded block */
-        m = malloc (sizeof *m + size);
-        if (!m)
+        SCE_Mem_SysFree (h);
+}
+
+static void* SCE_Mem_ResizeBlock (void *p, size_t size)
+{
+    SCE_SMemHeader *h = SCE_Mem_GetHeader (p);
+    void *new = NULL;
+
+    if (h->sclass) {
+        /* keep the slot as long as the new size stays in the same class */
+        if (size <= SCE_MEM_MAX_SMALL &&
+            SCE_Mem_GetArrayIndex (size) + 1 == h->sclass) {
+            h->size = size;
+            return p;
+        }
+    } else if (!h->flags && size > SCE_MEM_MAX_SMALL) {
+        if (!(h = SCE_Mem_SysRealloc (h, SCE_MEM_HEADER_SIZE + size))) {
             SCEE_Log (SCE_OUT_OF_MEMORY);
-        else
-            SCE_Mem_InitAlloc (m);
+            return NULL;
+        }
+        h->size = size;
+        return SCE_Mem_GetHeaderAddress (h);
+    }
+
+    if (h->flags & SCE_MEM_ALIGNED)
+        new = SCE_Mem_NewAlignedBlock (SCE_Mem_GetBlockAlign (p), size);
+    else
+        new = SCE_Mem_NewBlock (size);
+    if (!new) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    memcpy (new, p, h->size < size ? h->size : size);
+    SCE_Mem_GetHeader (new)->tag = h->tag;
+    SCE_Mem_DeleteBlock (p);
+    return new;
+}
+
+/* functions managing the table of allocations */
+
+#if SCE_USE_MEMORY_MANAGER
+static void SCE_Mem_InitAlloc (SCE_SMemAlloc *m)
+{
+    m->file = NULL;
+    m->line = 1;
+    m->size = 0;
+    m->block = NULL;
+    m->tag = SCE_MEM_TAG_NONE;
+    m->site = NULL;
+    m->next = NULL;
+}
+
+static SCE_SMemAlloc* SCE_Mem_NewAlloc (size_t align, size_t size)
+{
+    /* make one allocation for all: descriptor and demanded block, the
+       descriptor lies right before the block */
+    SCE_SMemAlloc *m = NULL;
+    void *block = NULL;
+    size_t pad = SCE_MEM_ALLOC_SIZE;
+
+    if (align > SCE_MEM_ALIGN) {
+        pad = (SCE_MEM_ALLOC_SIZE + align - 1) & ~(align - 1);
+        block = SCE_Mem_NewAlignedBlock (align, pad + size);
+    } else
+        block = SCE_Mem_NewBlock (pad + size);
+    if (!block) {
+        SCEE_LogSrc ();
+        return NULL;
     }
+    m = (SCE_SMemAlloc*)((unsigned char*)block + pad - SCE_MEM_ALLOC_SIZE);
+    SCE_Mem_InitAlloc (m);
+    m->block = block;
     return m;
 }
 
 static void SCE_Mem_DeleteAlloc (SCE_SMemAlloc *m)
 {
-    free (m);
+    SCE_Mem_DeleteBlock (m->block);
+}
+#endif
+
+#define SCE_Mem_GetAllocAddress(m)\
+    ((void*)((unsigned char*)(m) + SCE_MEM_ALLOC_SIZE))
+#define SCE_Mem_GetAllocFromAddress(p)\
+    ((SCE_SMemAlloc*)((unsigned char*)(p) - SCE_MEM_ALLOC_SIZE))
+
+static size_t SCE_Mem_Mix (size_t h)
+{
+    h ^= h >> 17;
+    h *= 0x9E3779B1u;
+    return h ^ (h >> 15);
 }
 
-#define SCE_Mem_GetAllocAddress(m) ((void*)&((SCE_SMemAlloc*)(m))[1])
+static size_t SCE_Mem_Hash (const SCE_SMemAlloc *m)
+{
+    /* descriptors are aligned on SCE_MEM_ALIGN, drop the bits always zero */
+    return SCE_Mem_Mix ((size_t)m / SCE_MEM_ALIGN);
+}
+
+static SCE_SMemShard* SCE_Mem_GetShard (size_t hash)
+{
+    return &shards[hash & (SCE_MEM_NUM_SHARDS - 1)];
+}
 
+static SCE_SMemAlloc** SCE_Mem_GetBucket (SCE_SMemShard *s, size_t hash)
+{
+    return &s->buckets[(hash / SCE_MEM_NUM_SHARDS) & (s->n_buckets - 1)];
+}
 
-static SCE_SMemAlloc* SCE_Mem_LocateAllocFromPointer (void *p)
+/* looks for \p m in the table and unlinks it if \p take is true */
+static SCE_SMemAlloc* SCE_Mem_LocateAlloc (SCE_SMemAlloc *m, int take)
 {
-    SCE_SMemAlloc *i = NULL;
-    SCE_SMemAlloc *al = p;
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        al = &al[-1];
-        SCE_Mem_For (i) {
-            if (i == al) {
-                pthread_mutex_unlock (&allocs_m);
-                return i;
+    size_t hash = SCE_Mem_Hash (m);
+    SCE_SMemShard *s = SCE_Mem_GetShard (hash);
+    SCE_SMemAlloc **b = NULL;
+
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    if (pthread_mutex_lock (&s->mutex) != 0)
+        return NULL;
+    if (s->n_buckets) {
+        for (b = SCE_Mem_GetBucket (s, hash); *b; b = &(*b)->next) {
+            if (*b == m) {
+                if (take) {
+                    *b = m->next;
+                    s->n_allocs--;
+                }
+                pthread_mutex_unlock (&s->mutex);
+                return m;
             }
         }
-        pthread_mutex_unlock (&allocs_m);
     }
+    pthread_mutex_unlock (&s->mutex);
     return NULL;
 }
 
+static SCE_SMemAlloc* SCE_Mem_LocateAllocFromPointer (void *p)
+{
+    return SCE_Mem_LocateAlloc (SCE_Mem_GetAllocFromAddress (p), SCE_FALSE);
+}
+
 
 int SCE_Mem_IsValid (void *p)
 {
@@ -322,81 +713,364 @@ int SCE_Mem_IsValid (void *p)
 }
 
 
-static void SCE_Mem_AddAlloc (SCE_SMemAlloc *m)
+#if SCE_USE_MEMORY_MANAGER
+/* doubles the number of buckets of \p s, \p s must be locked */
+static int SCE_Mem_GrowShard (SCE_SMemShard *s)
 {
-    m->prev = &allocs;
-    /* FIXME: errors not checked! */
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        m->next = allocs.next;
-        if (m->next)
-            m->next->prev = m;
-        allocs.next = m;
-        pthread_mutex_unlock (&allocs_m);
+    SCE_SMemAlloc **old = s->buckets;
+    size_t i, n = s->n_buckets;
+
+    s->n_buckets = n ? n * 2 : SCE_MEM_SHARD_BUCKETS;
+    if (!(s->buckets = SCE_Mem_SysCalloc (s->n_buckets, sizeof *s->buckets))) {
+        s->buckets = old;
+        s->n_buckets = n;
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
     }
+    for (i = 0; i < n; i++) {
+        SCE_SMemAlloc *m = old[i], *next = NULL;
+        for (; m; m = next) {
+            SCE_SMemAlloc **b = SCE_Mem_GetBucket (s, SCE_Mem_Hash (m));
+            next = m->next;
+            m->next = *b;
+            *b = m;
+        }
+    }
+    SCE_Mem_SysFree (old);
+    return SCE_OK;
 }
 
-static void SCE_Mem_EraseAlloc (SCE_SMemAlloc *m)
+static int SCE_Mem_AddAlloc (SCE_SMemAlloc *m)
 {
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        m->prev->next = m->next;
-        if (m->next)
-            m->next->prev = m->prev;
-#if 0
-        if (m->size <= SCE_NUM_MEMORY_ARRAYS)
-            SCE_Mem_EraseAllocFromArray (m);
-        else
-#endif
-        SCE_Mem_DeleteAlloc (m);
-        pthread_mutex_unlock (&allocs_m);
+    size_t hash = SCE_Mem_Hash (m);
+    SCE_SMemShard *s = SCE_Mem_GetShard (hash);
+    SCE_SMemAlloc **b = NULL;
+
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    if (pthread_mutex_lock (&s->mutex) != 0) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("failed to lock allocations table");
+        return SCE_ERROR;
+    }
+    if (s->n_allocs >= 2 * s->n_buckets && SCE_Mem_GrowShard (s) < 0) {
+        pthread_mutex_unlock (&s->mutex);
+        SCEE_LogSrc ();
+        return SCE_ERROR;
     }
+    b = SCE_Mem_GetBucket (s, hash);
+    m->next = *b;
+    *b = m;
+    s->n_allocs++;
+    pthread_mutex_unlock (&s->mutex);
+    return SCE_OK;
+}
+
+/* takes the descriptor of \p p out of the table */
+static SCE_SMemAlloc* SCE_Mem_RemoveAlloc (void *p)
+{
+    return SCE_Mem_LocateAlloc (SCE_Mem_GetAllocFromAddress (p), SCE_TRUE);
 }
+#endif
 
 
-/**
- * \brief SCE's malloc wrapper
- * \param s Size wanted for the block
- * \param file, line Where the block is asked
- * \returns a pointer to a newly allocated block on succes, NULL on failure
- * 
- * You will generally want to call SCE_malloc() that wraps this function.
- * 
- * \see SCE_malloc()
- */
-void* SCE_Mem_Alloc (const char *file, unsigned int line, size_t s)
+/* functions managing the callsites statistics */
+
+static size_t SCE_Mem_HashSite (const char *file, unsigned int line)
 {
-#if !SCE_USE_MEMORY_MANAGER
-    void *p = NULL;
-    (void)file;
-    (void)line;
-    p = malloc (s);
-    if (!p)
-        SCEE_Log (SCE_OUT_OF_MEMORY);
-    return p;
-#else
-    SCE_SMemAlloc *mem = NULL;
+    return SCE_Mem_Mix ((size_t)file ^ ((size_t)line * 0x9E3779B1u));
+}
 
-    mem = SCE_Mem_NewAlloc (s);
-    if (!mem) {
-        SCEE_LogSrc ();
-        return NULL;
+/* records \p n allocations totalizing \p size bytes at \p file:\p line */
+static SCE_SMemSite* SCE_Mem_AddToSite (const char *file, unsigned int line,
+                                        size_t n, size_t size)
+{
+    size_t hash = SCE_Mem_HashSite (file, line);
+    size_t b = hash & (SCE_MEM_SITE_BUCKETS - 1);
+    pthread_mutex_t *mutex = &sites_m[b % SCE_MEM_NUM_SHARDS];
+    SCE_SMemSiteEntry *e = NULL;
+    SCE_SMemSite *site = NULL;
+
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    pthread_mutex_lock (mutex);
+    for (e = sites[b]; e; e = e->next) {
+        if (e->site.file == file && e->site.line == line)
+            break;
     }
+    if (!e) {
+        /* not being able to allocate statistics is not an error */
+        if (!(e = SCE_Mem_SysCalloc (1, sizeof *e))) {
+            pthread_mutex_unlock (mutex);
+            return NULL;
+        }
+        e->site.file = file;
+        e->site.line = line;
+        e->next = sites[b];
+        sites[b] = e;
+    }
+    site = &e->site;
+    site->n_allocs += n;
+    site->total += size;
+    site->live += size;
+    if (site->live > site->peak)
+        site->peak = site->live;
+    pthread_mutex_unlock (mutex);
+    return site;
+}
 
-    mem->file = file;
-    mem->line = line;
-    mem->size = s;
+/* records \p n frees totalizing \p size bytes allocated at \p site */
+static void SCE_Mem_RemoveFromSite (SCE_SMemSite *site, size_t n,
+                                    size_t size)
+{
+    size_t hash = SCE_Mem_HashSite (site->file, site->line);
+    size_t b = hash & (SCE_MEM_SITE_BUCKETS - 1);
+    pthread_mutex_t *mutex = &sites_m[b % SCE_MEM_NUM_SHARDS];
 
-    SCE_Mem_AddAlloc (mem);
+    pthread_mutex_lock (mutex);
+    site->n_frees += n;
+    site->live -= size;
+    pthread_mutex_unlock (mutex);
+}
 
-    return SCE_Mem_GetAllocAddress (mem);
-#endif
+
+/* functions managing the sampled blocks */
+
+/* number of allocations a sample of \p bytes stands for */
+static size_t SCE_Mem_GetSampleCount (const SCE_SMemSample *sample,
+                                      size_t size)
+{
+    return size ? sample->bytes / size : 1;
 }
 
-/**
- * \brief Callocs wrapper
- * \param s Size of one item
- * \param n Num of item required
- * \param file, line Where the block is asked
- * \returns A pointer to a newly allocated block on success, NULL on failure
+#if !SCE_USE_MEMORY_MANAGER
+/* allocates a block of \p size bytes and accounts it to \p file:\p line */
+static void* SCE_Mem_NewSampledBlock (const char *file, unsigned int line,
+                                      size_t size)
+{
+    SCE_SMemSample *sample = NULL;
+    SCE_SMemHeader *h = NULL;
+    size_t rate = sample_rate;
+
+    if (!rate) {
+        sample_countdown = SCE_MEM_SAMPLE_RECHECK;
+        return SCE_Mem_NewBlock (size);
+    }
+    /* pick the next interval in [rate/2, 3*rate/2) so that periodic
+       allocation patterns do not always hit the same callsite */
+    if (!sample_seed)
+        sample_seed = (unsigned int)(size_t)&sample_seed | 1;
+    sample_seed ^= sample_seed << 13;
+    sample_seed ^= sample_seed >> 17;
+    sample_seed ^= sample_seed << 5;
+    sample_countdown = rate / 2 + sample_seed % rate;
+
+    if (!(sample = SCE_Mem_SysAlloc (SCE_MEM_SAMPLE_SIZE + SCE_MEM_HEADER_SIZE +
+                                     size))) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    /* a sample stands for all the bytes allocated since the last one */
+    sample->bytes = size > rate ? size : rate;
+    sample->site = SCE_Mem_AddToSite (file, line,
+                                      SCE_Mem_GetSampleCount (sample, size),
+                                      sample->bytes);
+    h = (SCE_SMemHeader*)((unsigned char*)sample + SCE_MEM_SAMPLE_SIZE);
+    h->size = size;
+    h->sclass = 0;
+    h->flags = SCE_MEM_SAMPLED;
+    h->tag = SCE_MEM_TAG_NONE;
+    return SCE_Mem_GetHeaderAddress (h);
+}
+#endif
+
+static void SCE_Mem_DeleteSampledBlock (SCE_SMemHeader *h)
+{
+    SCE_SMemSample *sample =
+        (SCE_SMemSample*)((unsigned char*)h - SCE_MEM_SAMPLE_SIZE);
+    if (sample->site)
+        SCE_Mem_RemoveFromSite (sample->site,
+                                SCE_Mem_GetSampleCount (sample, h->size),
+                                sample->bytes);
+    SCE_Mem_SysFree (sample);
+}
+
+/**
+ * \brief Enables the sampling of the allocations
+ * \param rate average number of bytes between two samples, 0 disables
+ * sampling
+ *
+ * In non-debug builds, roughly one allocation every \p rate bytes is
+ * accounted to its callsite, see SCE_Mem_TakeSnapshot(). Each sample stands
+ * for \p rate bytes, the statistics are thus estimates. Each thread counts
+ * down the bytes it allocates, so the cost is one subtraction per allocation
+ * when no sample is taken. A thread notices a change of rate once it has
+ * allocated 1MB, or one interval of the previous rate.
+ *
+ * Debug builds record every allocation and ignore this setting.
+ */
+void SCE_Mem_SetSampleRate (size_t rate)
+{
+    sample_rate = rate;
+}
+/**
+ * \brief Gets the sampling rate set by SCE_Mem_SetSampleRate()
+ */
+size_t SCE_Mem_GetSampleRate (void)
+{
+    return sample_rate;
+}
+
+
+
+/* adds \p delta bytes to the live size of \p t only if it stays within its
+   hard budget, \p live receives the new live size on success or the one
+   that did not fit */
+static int SCE_Mem_ReserveTag (SCE_SMemTag *t, long delta, long *live)
+{
+    long old = __atomic_load_n (&t->live, __ATOMIC_RELAXED);
+    do {
+        if ((size_t)(old + delta) > t->hard) {
+            *live = old;
+            return SCE_FALSE;
+        }
+    } while (!__atomic_compare_exchange_n (&t->live, &old, old + delta, 1,
+                                           __ATOMIC_RELAXED,
+                                           __ATOMIC_RELAXED));
+    *live = old + delta;
+    return SCE_TRUE;
+}
+/* adds \p delta bytes to the live size of \p tag, fails when it would
+   exceed the hard budget of \p tag */
+static int SCE_Mem_ChargeTag (unsigned int tag, long delta)
+{
+    SCE_SMemTag *t = &tags[tag];
+    long live;
+
+    if (delta > 0 && t->hard) {
+        if (!SCE_Mem_ReserveTag (t, delta, &live)) {
+            /* give the callback a chance to release memory */
+            if (t->func)
+                t->func (tag, SCE_MEM_BUDGET_HARD, live, delta, t->data);
+            if (!SCE_Mem_ReserveTag (t, delta, &live)) {
+                SCEE_Log (SCE_OUT_OF_MEMORY);
+                SCEE_LogMsg ("hard budget of memory tag '%s' exceeded: "
+                             "%ld bytes used, %ld asked, budget is %zu",
+                             t->name ? t->name : "", live, delta, t->hard);
+                return SCE_ERROR;
+            }
+        }
+    } else
+        live = __atomic_add_fetch (&t->live, delta, __ATOMIC_RELAXED);
+    if (delta > 0) {
+        long peak = __atomic_load_n (&t->peak, __ATOMIC_RELAXED);
+        while (live > peak &&
+               !__atomic_compare_exchange_n (&t->peak, &peak, live, 1,
+                                             __ATOMIC_RELAXED,
+                                             __ATOMIC_RELAXED));
+        if (t->soft && t->func && (size_t)live > t->soft &&
+            (size_t)(live - delta) <= t->soft)
+            t->func (tag, SCE_MEM_BUDGET_SOFT, live, delta, t->data);
+    }
+    return SCE_OK;
+}
+
+/* tag and size of the block \p p */
+static unsigned int SCE_Mem_GetTag (void *p, size_t *size)
+{
+#if !SCE_USE_MEMORY_MANAGER
+    SCE_SMemHeader *h = SCE_Mem_GetHeader (p);
+    *size = h->size;
+    return h->tag;
+#else
+    SCE_SMemAlloc *m = SCE_Mem_LocateAllocFromPointer (p);
+    if (!m) {
+        *size = 0;
+        return SCE_MEM_TAG_NONE;
+    }
+    *size = m->size;
+    return m->tag;
+#endif
+}
+static void SCE_Mem_SetTag (void *p, unsigned int tag)
+{
+#if !SCE_USE_MEMORY_MANAGER
+    SCE_Mem_GetHeader (p)->tag = tag;
+#else
+    SCE_SMemAlloc *m = SCE_Mem_LocateAllocFromPointer (p);
+    if (m)
+        m->tag = tag;
+#endif
+}
+
+#if SCE_USE_MEMORY_MANAGER
+/* allocates a block and records it in the allocations table */
+static void* SCE_Mem_NewTrackedBlock (const char *file, unsigned int line,
+                                      size_t align, size_t s)
+{
+    SCE_SMemAlloc *mem = NULL;
+
+    mem = SCE_Mem_NewAlloc (align, s);
+    if (!mem) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+
+    mem->file = file;
+    mem->line = line;
+    mem->size = s;
+    mem->site = SCE_Mem_AddToSite (file, line, 1, s);
+
+    if (SCE_Mem_AddAlloc (mem) < 0) {
+        if (mem->site)
+            SCE_Mem_RemoveFromSite (mem->site, 1, s);
+        SCE_Mem_DeleteAlloc (mem);
+        SCEE_LogSrc ();
+        return NULL;
+    }
+
+    return SCE_Mem_GetAllocAddress (mem);
+}
+#endif
+
+/* SCE_Mem_Alloc() without the malloc attribute, which would make the
+   compiler complain about accesses to the header of the block */
+static void* SCE_Mem_NewUserBlock (const char *file, unsigned int line,
+                                   size_t s)
+{
+#if !SCE_USE_MEMORY_MANAGER
+    void *p = NULL;
+    if ((sample_countdown -= (long)s) < 0)
+        p = SCE_Mem_NewSampledBlock (file, line, s);
+    else
+        p = SCE_Mem_NewBlock (s);
+    if (!p)
+        SCEE_LogSrc ();
+    return p;
+#else
+    return SCE_Mem_NewTrackedBlock (file, line, SCE_MEM_ALIGN, s);
+#endif
+}
+
+/**
+ * \brief SCE's malloc wrapper
+ * \param s Size wanted for the block
+ * \param file, line Where the block is asked
+ * \returns a pointer to a newly allocated block on succes, NULL on failure
+ * 
+ * You will generally want to call SCE_malloc() that wraps this function.
+ * 
+ * \see SCE_malloc()
+ */
+void* SCE_Mem_Alloc (const char *file, unsigned int line, size_t s)
+{
+    return SCE_Mem_NewUserBlock (file, line, s);
+}
+
+/**
+ * \brief Callocs wrapper
+ * \param s Size of one item
+ * \param n Num of item required
+ * \param file, line Where the block is asked
+ * \returns A pointer to a newly allocated block on success, NULL on failure
  * \sa SCE_Mem_Alloc SCE_Mem_Free
  * 
  * You will generally want to call SCE_calloc() that wraps this function.
@@ -405,20 +1079,18 @@ void* SCE_Mem_Alloc (const char *file, unsigned int line, size_t s)
  */
 void* SCE_Mem_Calloc (const char *file, unsigned int line, size_t s, size_t n)
 {
-#if !SCE_USE_MEMORY_MANAGER
     void *p = NULL;
-    (void)file;
-    (void)line;
-    p = calloc (s, n);
-    if (!p)
+
+    if (n && s > SIZE_MAX / n) {
         SCEE_Log (SCE_OUT_OF_MEMORY);
-    return p;
-#else
-    void *p = SCE_Mem_Alloc (file, line, s * n);
+        SCEE_LogMsg ("calloc of %lu items of %lu bytes overflows",
+                     (unsigned long)n, (unsigned long)s);
+        return NULL;
+    }
+    p = SCE_Mem_Alloc (file, line, s * n);
     if (p)
         memset (p, 0, s * n);
     return p;
-#endif
 }
 
 /**
@@ -433,43 +1105,79 @@ void* SCE_Mem_Calloc (const char *file, unsigned int line, size_t s, size_t n)
  * You will generally want to call SCE_realloc() that wraps this function.
  * 
  * \see SCE_realloc()
- * \todo this function doesn't work
- * \warning this function doesn't work, do not use it
  */
 void* SCE_Mem_Realloc (const char *file, unsigned int line, void *p, size_t s)
 {
 #if !SCE_USE_MEMORY_MANAGER
-    (void)file;
-    (void)line;
-    p = realloc (p, s);
+    SCE_SMemHeader *h = NULL;
+    void *new = NULL;
+    long delta;
+
     if (!p)
-        SCEE_Log (SCE_OUT_OF_MEMORY);
-    return p;
+        return SCE_Mem_Alloc (file, line, s);
+    h = SCE_Mem_GetHeader (p);
+    delta = (long)s - (long)h->size;
+    if (h->tag && SCE_Mem_ChargeTag (h->tag, delta) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (!(new = SCE_Mem_ResizeBlock (p, s))) {
+        if (h->tag)
+            SCE_Mem_ChargeTag (h->tag, -delta);
+        SCEE_LogSrc ();
+    }
+    return new;
 #else
-    SCE_SMemAlloc *mem = NULL;
+    SCE_SMemAlloc *mem = NULL, *new = NULL;
 
     if (!p)
         return SCE_Mem_Alloc (file, line, s); /* nouvelle allocation */
     else {
-        mem = SCE_Mem_LocateAllocFromPointer (p);
+        /* the descriptor may move, take it out of the table meanwhile */
+        mem = SCE_Mem_RemoveAlloc (p);
         if (!mem) {
             SCEE_Log (SCE_INVALID_POINTER);
             return NULL;
         }
-        mem = realloc (mem, sizeof *mem + s);
-        if (!mem) {
+        if (mem->block != (void*)mem) {
+            /* the descriptor is not at the start of the block, keep the
+               alignment the block was allocated with */
+            SCE_Mem_AddAlloc (mem);
+            return SCE_Mem_ReallocAligned (file, line, p,
+                                           SCE_Mem_GetBlockAlign (mem->block),
+                                           s);
+        }
+        if (mem->tag &&
+            SCE_Mem_ChargeTag (mem->tag, (long)s - (long)mem->size) < 0) {
+            SCE_Mem_AddAlloc (mem);
+            SCEE_LogSrc ();
+            return NULL;
+        }
+        new = SCE_Mem_ResizeBlock (mem, SCE_MEM_ALLOC_SIZE + s);
+        if (!new) {
             /* en cas d'echec realloc conserve la memoire deja alloue,
                donc on ne libere aucune memoire */
-            SCEE_Log (SCE_OUT_OF_MEMORY);
+            if (mem->tag)
+                SCE_Mem_ChargeTag (mem->tag, (long)mem->size - (long)s);
+            SCE_Mem_AddAlloc (mem);
+            SCEE_LogSrc ();
             return NULL;
         }
-        if (mem->prev)
-            mem->prev->next = mem;
-        if (mem->next)
-            mem->next->prev = mem;
+        mem = new;
+        mem->block = mem;
+        if (mem->site)
+            SCE_Mem_RemoveFromSite (mem->site, 1, mem->size);
         mem->size = s;
         mem->line = line;
         mem->file = file;
+        mem->site = SCE_Mem_AddToSite (file, line, 1, s);
+        if (SCE_Mem_AddAlloc (mem) < 0) {
+            if (mem->site)
+                SCE_Mem_RemoveFromSite (mem->site, 1, s);
+            SCE_Mem_DeleteAlloc (mem);
+            SCEE_LogSrc ();
+            return NULL;
+        }
     }
 
     return SCE_Mem_GetAllocAddress (mem);
@@ -489,12 +1197,29 @@ void* SCE_Mem_Realloc (const char *file, unsigned int line, void *p, size_t s)
 void SCE_Mem_Free (const char *file, int line, void *p)
 {
 #if !SCE_USE_MEMORY_MANAGER
-    free (p);
+    (void)file;
+    (void)line;
+    if (p) {
+        SCE_SMemHeader *h = SCE_Mem_GetHeader (p);
+        if (h->tag) {
+            SCE_Mem_ChargeTag (h->tag, -(long)h->size);
+            __atomic_add_fetch (&tags[h->tag].n_frees, 1, __ATOMIC_RELAXED);
+        }
+        SCE_Mem_DeleteBlock (p);
+    }
 #else
     if (p) {
-        SCE_SMemAlloc *m = SCE_Mem_LocateAllocFromPointer (p);
-        if (m && m != &allocs)
-            SCE_Mem_EraseAlloc (m);
+        SCE_SMemAlloc *m = SCE_Mem_RemoveAlloc (p);
+        if (m) {
+            if (m->site)
+                SCE_Mem_RemoveFromSite (m->site, 1, m->size);
+            if (m->tag) {
+                SCE_Mem_ChargeTag (m->tag, -(long)m->size);
+                __atomic_add_fetch (&tags[m->tag].n_frees, 1,
+                                    __ATOMIC_RELAXED);
+            }
+            SCE_Mem_DeleteAlloc (m);
+        }
         else
             SCEE_SendMsg ("SCE_Mem_Free(): trying to free an invalid pointer %p"
                           " at %s(%d).\n", p, file, line);
@@ -502,6 +1227,248 @@ void SCE_Mem_Free (const char *file, int line, void *p)
 #endif
 }
 
+/**
+ * \brief Frees a pointer allocated by SCE_Mem_Alloc
+ * \param p Pointer to free
+ *
+ * Same as SCE_Mem_Free() but without the location of the call, this is the
+ * function SCE_free() expands to in non-debug builds.
+ * \see SCE_free, SCE_Mem_Free()
+ */
+void SCE_Mem_Release (void *p)
+{
+    SCE_Mem_Free (NULL, 0, p);
+}
+
+
+static int SCE_Mem_CheckAlign (size_t align)
+{
+    if (!align || (align & (align - 1))) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("alignment must be a power of two, got %zu", align);
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/* SCE_Mem_AllocAligned() without the malloc attribute, see
+   SCE_Mem_NewUserBlock() */
+static void* SCE_Mem_NewUserAlignedBlock (const char *file, unsigned int line,
+                                          size_t align, size_t s)
+{
+    void *p = NULL;
+    if (SCE_Mem_CheckAlign (align) < 0)
+        return NULL;
+#if !SCE_USE_MEMORY_MANAGER
+    if (align <= SCE_MEM_ALIGN)
+        p = SCE_Mem_NewUserBlock (file, line, s);
+    else
+        p = SCE_Mem_NewAlignedBlock (align, s);
+#else
+    p = SCE_Mem_NewTrackedBlock (file, line, align, s);
+#endif
+    if (!p)
+        SCEE_LogSrc ();
+    return p;
+}
+
+/**
+ * \brief Allocates an aligned block
+ * \param file, line Where the block is asked
+ * \param align alignment of the block, must be a power of two
+ * \param s Size wanted for the block
+ * \returns a pointer to a newly allocated block on succes, NULL on failure
+ *
+ * The block can be reallocated with SCE_Mem_ReallocAligned() or
+ * SCE_Mem_Realloc(), both keep its alignment. It is freed by
+ * SCE_Mem_FreeAligned() or SCE_Mem_Free(). You will generally want to call
+ * SCE_malloc_aligned() that wraps this function.
+ *
+ * \see SCE_malloc_aligned()
+ */
+void* SCE_Mem_AllocAligned (const char *file, unsigned int line, size_t align,
+                            size_t s)
+{
+    return SCE_Mem_NewUserAlignedBlock (file, line, align, s);
+}
+
+/**
+ * \brief Reallocates an aligned block
+ * \param file, line Where the block is asked
+ * \param p Old pointer
+ * \param align alignment of the new block, must be a power of two
+ * \param s New size wanted for the block
+ * \returns A pointer to the reallocated block on success, NULL on failure
+ *
+ * On failure \p p is left untouched. You will generally want to call
+ * SCE_realloc_aligned() that wraps this function.
+ *
+ * \see SCE_realloc_aligned()
+ */
+void* SCE_Mem_ReallocAligned (const char *file, unsigned int line, void *p,
+                              size_t align, size_t s)
+{
+    void *new = NULL;
+    size_t size;
+    unsigned int tag;
+
+    if (!p)
+        return SCE_Mem_AllocAligned (file, line, align, s);
+#if SCE_USE_MEMORY_MANAGER
+    if (!SCE_Mem_LocateAllocFromPointer (p)) {
+        SCEE_Log (SCE_INVALID_POINTER);
+        return NULL;
+    }
+#endif
+    tag = SCE_Mem_GetTag (p, &size);
+    if (tag && SCE_Mem_ChargeTag (tag, (long)s - (long)size) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (!(new = SCE_Mem_NewUserAlignedBlock (file, line, align, s))) {
+        if (tag)
+            SCE_Mem_ChargeTag (tag, (long)size - (long)s);
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    memcpy (new, p, size < s ? size : s);
+    if (tag) {
+        /* the tag has already been charged for the new size */
+        SCE_Mem_SetTag (new, tag);
+        SCE_Mem_SetTag (p, SCE_MEM_TAG_NONE);
+    }
+    SCE_Mem_Free (file, line, p);
+    return new;
+}
+
+/**
+ * \brief Frees an aligned block
+ * \param file File from which the block is freed
+ * \param line Line at which the block is freed
+ * \param p Pointer to free
+ *
+ * You will generally want to call SCE_free_aligned() that wraps this
+ * function.
+ * \see SCE_free_aligned(), SCE_Mem_Free()
+ */
+void SCE_Mem_FreeAligned (const char *file, int line, void *p)
+{
+    SCE_Mem_Free (file, line, p);
+}
+
+
+static int SCE_Mem_CheckTag (unsigned int tag)
+{
+    if (tag >= SCE_MEM_NUM_TAGS) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("invalid memory tag %u, maximum is %d", tag,
+                     SCE_MEM_NUM_TAGS - 1);
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Allocates a block accounted to a memory tag
+ * \param file, line Where the block is asked
+ * \param tag memory tag of the block, see SCE_EMemTag
+ * \param s Size wanted for the block
+ * \returns a pointer to a newly allocated block on succes, NULL on failure
+ *
+ * Works like SCE_Mem_Alloc() but adds the block to the counters of \p tag,
+ * in release builds too. The block keeps its tag when it is reallocated.
+ * The allocation fails if it would exceed the hard budget of \p tag. You
+ * will generally want to call SCE_malloc_tagged() that wraps this function.
+ * \see SCE_malloc_tagged(), SCE_Mem_SetTagBudget()
+ */
+void* SCE_Mem_AllocTagged (const char *file, unsigned int line,
+                           unsigned int tag, size_t s)
+{
+    void *p = NULL;
+
+    if (SCE_Mem_CheckTag (tag) < 0)
+        return NULL;
+    if (tag == SCE_MEM_TAG_NONE)
+        return SCE_Mem_Alloc (file, line, s);
+    if (SCE_Mem_ChargeTag (tag, s) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (!(p = SCE_Mem_NewUserBlock (file, line, s))) {
+        SCE_Mem_ChargeTag (tag, -(long)s);
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    SCE_Mem_SetTag (p, tag);
+    __atomic_add_fetch (&tags[tag].n_allocs, 1, __ATOMIC_RELAXED);
+    return p;
+}
+
+/**
+ * \brief Names a memory tag
+ * \param tag a memory tag
+ * \param name name of \p tag, the string is not copied
+ */
+void SCE_Mem_SetTagName (unsigned int tag, const char *name)
+{
+    if (SCE_Mem_CheckTag (tag) == SCE_OK)
+        tags[tag].name = name;
+}
+/**
+ * \brief Sets the budgets of a memory tag
+ * \param tag a memory tag
+ * \param soft size above which the budget callback of \p tag is warned
+ * \param hard size above which the allocations of \p tag fail
+ *
+ * A budget of 0 means unlimited, which is the default.
+ * \sa SCE_Mem_SetBudgetCallback()
+ */
+void SCE_Mem_SetTagBudget (unsigned int tag, size_t soft, size_t hard)
+{
+    if (SCE_Mem_CheckTag (tag) == SCE_OK) {
+        tags[tag].soft = soft;
+        tags[tag].hard = hard;
+    }
+}
+/**
+ * \brief Sets the function called when a budget of a memory tag is exceeded
+ * \param tag a memory tag
+ * \param func function to call, NULL to disable
+ * \param data user data given to \p func
+ *
+ * \p func is called once each time the soft budget is crossed, and before
+ * an allocation exceeding the hard budget fails: it can release memory of
+ * \p tag to let the allocation succeed. It may be called from any thread
+ * allocating memory of \p tag.
+ */
+void SCE_Mem_SetBudgetCallback (unsigned int tag, SCE_FMemBudgetFunc func,
+                                void *data)
+{
+    if (SCE_Mem_CheckTag (tag) == SCE_OK) {
+        tags[tag].func = func;
+        tags[tag].data = data;
+    }
+}
+/**
+ * \brief Gets the counters of a memory tag
+ * \param tag a memory tag
+ * \param stats filled with the counters of \p tag
+ */
+void SCE_Mem_GetTagStats (unsigned int tag, SCE_SMemTagStats *stats)
+{
+    SCE_SMemTag *t = NULL;
+    if (SCE_Mem_CheckTag (tag) < 0)
+        return;
+    t = &tags[tag];
+    stats->name = t->name;
+    stats->live = __atomic_load_n (&t->live, __ATOMIC_RELAXED);
+    stats->peak = __atomic_load_n (&t->peak, __ATOMIC_RELAXED);
+    stats->n_allocs = __atomic_load_n (&t->n_allocs, __ATOMIC_RELAXED);
+    stats->n_frees = __atomic_load_n (&t->n_frees, __ATOMIC_RELAXED);
+    stats->soft = t->soft;
+    stats->hard = t->hard;
+}
+
 
 /**
  * \brief Duplicates allocated memory and copies its content
@@ -524,11 +1491,20 @@ void* SCE_Mem_Dup (const void *p, size_t size)
 void SCE_Mem_List (void)
 {
     unsigned int n = 0;
+    size_t i, j;
     SCE_SMemAlloc *a = NULL;
-    SCE_Mem_For (a) {
-        SCEE_SendMsg ("- allocation in %s (%u): %zu bytes.\n",
-                      a->file, a->line, a->size);
-        n++;
+
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    for (i = 0; i < SCE_MEM_NUM_SHARDS; i++) {
+        pthread_mutex_lock (&shards[i].mutex);
+        for (j = 0; j < shards[i].n_buckets; j++) {
+            for (a = shards[i].buckets[j]; a; a = a->next) {
+                SCEE_SendMsg ("- allocation in %s (%u): %zu bytes.\n",
+                              a->file, a->line, a->size);
+                n++;
+            }
+        }
+        pthread_mutex_unlock (&shards[i].mutex);
     }
     SCEE_SendMsg ("you have %u non-freeds allocations.\n", n);
 }
@@ -567,4 +1543,353 @@ const char* SCE_Mem_GetFile (void *p)
 }
 /*#endif*/
 
+/**
+ * \brief Initializes a snapshot of the callsites statistics
+ * \sa SCE_Mem_TakeSnapshot(), SCE_Mem_ClearSnapshot()
+ */
+void SCE_Mem_InitSnapshot (SCE_SMemSnapshot *snap)
+{
+    snap->sites = NULL;
+    snap->n_sites = 0;
+}
+/**
+ * \brief Clears a snapshot
+ */
+void SCE_Mem_ClearSnapshot (SCE_SMemSnapshot *snap)
+{
+    SCE_Mem_SysFree (snap->sites);
+    SCE_Mem_InitSnapshot (snap);
+}
+
+/**
+ * \brief Copies the statistics of every callsite
+ * \param snap an initialized snapshot, its previous content is cleared
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Callsites are recorded for every allocation in debug builds, and for the
+ * sampled allocations otherwise (see SCE_Mem_SetSampleRate()). The sites are
+ * not sorted, see SCE_Mem_SortSnapshot().
+ */
+int SCE_Mem_TakeSnapshot (SCE_SMemSnapshot *snap)
+{
+    size_t i, n = 0;
+    SCE_SMemSiteEntry *e = NULL;
+
+    SCE_Mem_ClearSnapshot (snap);
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    /* sites are never removed, new ones will show up in the next snapshot */
+    for (i = 0; i < SCE_MEM_SITE_BUCKETS; i++) {
+        pthread_mutex_lock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+        for (e = sites[i]; e; e = e->next)
+            n++;
+        pthread_mutex_unlock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+    }
+    if (!n)
+        return SCE_OK;
+    if (!(snap->sites = SCE_Mem_SysAlloc (n * sizeof *snap->sites))) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
+    }
+    for (i = 0; i < SCE_MEM_SITE_BUCKETS && snap->n_sites < n; i++) {
+        pthread_mutex_lock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+        for (e = sites[i]; e && snap->n_sites < n; e = e->next)
+            snap->sites[snap->n_sites++] = e->site;
+        pthread_mutex_unlock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+    }
+    return SCE_OK;
+}
+
+static int SCE_Mem_CompareSites (const void *a, const void *b)
+{
+    const SCE_SMemSite *s1 = a, *s2 = b;
+    if (s1->file != s2->file)
+        return (size_t)s1->file < (size_t)s2->file ? -1 : 1;
+    return s1->line < s2->line ? -1 : s1->line > s2->line;
+}
+
+/**
+ * \brief Computes the activity of the callsites between two snapshots
+ * \param from the older snapshot
+ * \param to the newer snapshot
+ * \param diff an initialized snapshot receiving the result
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * The counters of \p diff are the differences between \p to and \p from,
+ * except SCE_SMemSite::peak which is the one of \p to (see
+ * SCE_Mem_ResetPeaks()). Callsites without any allocation nor free in the
+ * interval are left out.
+ */
+int SCE_Mem_DiffSnapshots (const SCE_SMemSnapshot *from,
+                           const SCE_SMemSnapshot *to, SCE_SMemSnapshot *diff)
+{
+    SCE_SMemSite *sorted = NULL;
+    size_t i;
+
+    SCE_Mem_ClearSnapshot (diff);
+    if (!to->n_sites)
+        return SCE_OK;
+    if (!(diff->sites = SCE_Mem_SysAlloc (to->n_sites * sizeof *diff->sites)))
+        goto fail;
+    if (from->n_sites) {
+        if (!(sorted = SCE_Mem_SysAlloc (from->n_sites * sizeof *sorted)))
+            goto fail;
+        memcpy (sorted, from->sites, from->n_sites * sizeof *sorted);
+        qsort (sorted, from->n_sites, sizeof *sorted, SCE_Mem_CompareSites);
+    }
+
+    for (i = 0; i < to->n_sites; i++) {
+        SCE_SMemSite *d = &diff->sites[diff->n_sites];
+        SCE_SMemSite *old = NULL;
+        *d = to->sites[i];
+        if (sorted)
+            old = bsearch (d, sorted, from->n_sites, sizeof *sorted,
+                           SCE_Mem_CompareSites);
+        if (old) {
+            d->n_allocs -= old->n_allocs;
+            d->n_frees -= old->n_frees;
+            d->total -= old->total;
+            d->live -= old->live;
+        }
+        if (d->n_allocs || d->n_frees)
+            diff->n_sites++;
+    }
+    SCE_Mem_SysFree (sorted);
+    return SCE_OK;
+fail:
+    SCE_Mem_ClearSnapshot (diff);
+    SCEE_Log (SCE_OUT_OF_MEMORY);
+    return SCE_ERROR;
+}
+
+static int SCE_Mem_CompareLive (const void *a, const void *b)
+{
+    const SCE_SMemSite *s1 = a, *s2 = b;
+    return s1->live < s2->live ? 1 : s1->live > s2->live ? -1 : 0;
+}
+static int SCE_Mem_ComparePeak (const void *a, const void *b)
+{
+    const SCE_SMemSite *s1 = a, *s2 = b;
+    return s1->peak < s2->peak ? 1 : s1->peak > s2->peak ? -1 : 0;
+}
+static int SCE_Mem_CompareTotal (const void *a, const void *b)
+{
+    const SCE_SMemSite *s1 = a, *s2 = b;
+    return s1->total < s2->total ? 1 : s1->total > s2->total ? -1 : 0;
+}
+static int SCE_Mem_CompareAllocs (const void *a, const void *b)
+{
+    const SCE_SMemSite *s1 = a, *s2 = b;
+    return s1->n_allocs < s2->n_allocs ? 1 :
+        s1->n_allocs > s2->n_allocs ? -1 : 0;
+}
+
+/**
+ * \brief Sorts the callsites of a snapshot, biggest first
+ * \param snap a snapshot
+ * \param key the counter to sort on
+ */
+void SCE_Mem_SortSnapshot (SCE_SMemSnapshot *snap, SCE_EMemSiteKey key)
+{
+    int (*cmp)(const void*, const void*) = NULL;
+    switch (key) {
+    case SCE_MEM_SITE_LIVE: cmp = SCE_Mem_CompareLive; break;
+    case SCE_MEM_SITE_PEAK: cmp = SCE_Mem_ComparePeak; break;
+    case SCE_MEM_SITE_TOTAL: cmp = SCE_Mem_CompareTotal; break;
+    case SCE_MEM_SITE_ALLOCS: cmp = SCE_Mem_CompareAllocs; break;
+    }
+    if (cmp && snap->n_sites)
+        qsort (snap->sites, snap->n_sites, sizeof *snap->sites, cmp);
+}
+
+/**
+ * \brief Writes a snapshot in CSV format
+ * \param snap a snapshot
+ * \param fp output stream
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * The first line names the columns: file, line, allocs, frees, live, peak
+ * and total. One line per callsite follows.
+ */
+int SCE_Mem_WriteSnapshot (const SCE_SMemSnapshot *snap, FILE *fp)
+{
+    size_t i;
+    fprintf (fp, "file,line,allocs,frees,live,peak,total\n");
+    for (i = 0; i < snap->n_sites; i++) {
+        const SCE_SMemSite *site = &snap->sites[i];
+        fprintf (fp, "\"%s\",%u,%zu,%zu,%ld,%ld,%zu\n",
+                 site->file ? site->file : "", site->line, site->n_allocs,
+                 site->n_frees, site->live, site->peak, site->total);
+    }
+    if (ferror (fp)) {
+        SCEE_LogErrno ("failed to write memory snapshot");
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Sets the peak of every callsite to its current live size
+ *
+ * Calling this at the start of a frame makes SCE_SMemSite::peak report the
+ * peak of the frame. The peaks of the memory tags are reset as well.
+ */
+void SCE_Mem_ResetPeaks (void)
+{
+    size_t i;
+    SCE_SMemSiteEntry *e = NULL;
+
+    for (i = 0; i < SCE_MEM_NUM_TAGS; i++)
+        __atomic_store_n (&tags[i].peak,
+                          __atomic_load_n (&tags[i].live, __ATOMIC_RELAXED),
+                          __ATOMIC_RELAXED);
+
+    pthread_once (&shards_once, SCE_Mem_InitShards);
+    for (i = 0; i < SCE_MEM_SITE_BUCKETS; i++) {
+        pthread_mutex_lock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+        for (e = sites[i]; e; e = e->next)
+            e->site.peak = e->site.live;
+        pthread_mutex_unlock (&sites_m[i % SCE_MEM_NUM_SHARDS]);
+    }
+}
+
+
+/**
+ * \brief Initializes a region
+ * \sa SCE_Mem_ReserveRegion(), SCE_Mem_ClearRegion()
+ */
+void SCE_Mem_InitRegion (SCE_SMemRegion *r)
+{
+    r->base = NULL;
+    r->reserved = r->committed = 0;
+}
+/**
+ * \brief Clears a region, gives its address space back to the system
+ */
+void SCE_Mem_ClearRegion (SCE_SMemRegion *r)
+{
+    if (r->base)
+        munmap (r->base, r->reserved);
+    SCE_Mem_InitRegion (r);
+}
+
+static size_t SCE_Mem_GetPageSize (void)
+{
+    static size_t page_size = 0;
+    if (!page_size)
+        page_size = sysconf (_SC_PAGESIZE);
+    return page_size;
+}
+
+/* granularity of the commits of \p r */
+static size_t SCE_Mem_GetCommitStep (const SCE_SMemRegion *r)
+{
+    if (r->reserved >= SCE_MEM_HUGE_PAGE_SIZE)
+        return SCE_MEM_HUGE_PAGE_SIZE;
+    return SCE_Mem_GetPageSize ();
+}
+
+/**
+ * \brief Reserves address space for a large buffer
+ * \param r an initialized region
+ * \param max maximum size the buffer will ever reach
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * No memory is used until SCE_Mem_CommitRegion() is called, only address
+ * space: \p max can thus be much larger than what is usually needed.
+ * Growing the buffer with SCE_Mem_CommitRegion() never moves it, nothing is
+ * copied. Regions of at least SCE_MEM_HUGE_PAGE_SIZE bytes are aligned on
+ * huge pages and asked to be backed by transparent huge pages, which cuts
+ * the number of page faults and TLB misses on big buffers.
+ *
+ * Regions are not tracked by the memory manager, SCE_Mem_List() does not
+ * report them.
+ * \sa SCE_Mem_CommitRegion(), SCE_Mem_ClearRegion()
+ */
+int SCE_Mem_ReserveRegion (SCE_SMemRegion *r, size_t max)
+{
+    unsigned char *p = NULL, *base = NULL;
+    size_t align, size;
+
+    if (r->base) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("region already reserved");
+        return SCE_ERROR;
+    }
+    r->reserved = max;
+    align = SCE_Mem_GetCommitStep (r);
+    max = (max + align - 1) & ~(align - 1);
+    /* over-reserve to align the region on huge pages */
+    size = max + (align > SCE_Mem_GetPageSize () ? align : 0);
+    p = mmap (NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS |
+              MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        r->reserved = 0;
+        SCEE_LogErrno ("failed to reserve address space");
+        return SCE_ERROR;
+    }
+    base = (unsigned char*)(((size_t)p + align - 1) & ~(align - 1));
+    if (base > p)
+        munmap (p, base - p);
+    if (p + size > base + max)
+        munmap (base + max, p + size - (base + max));
+#ifdef MADV_HUGEPAGE
+    if (align > SCE_Mem_GetPageSize ())
+        madvise (base, max, MADV_HUGEPAGE); /* not fatal when unavailable */
+#endif
+    r->base = base;
+    r->reserved = max;
+    r->committed = 0;
+    return SCE_OK;
+}
+
+/**
+ * \brief Makes the first bytes of a region usable
+ * \param r a reserved region
+ * \param size number of bytes needed from the start of the region
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The committed size is rounded up to pages, or to huge pages for large
+ * regions. The region never shrinks, and its data is kept in place.
+ * \sa SCE_Mem_ReserveRegion(), SCE_Mem_GetRegionSize()
+ */
+int SCE_Mem_CommitRegion (SCE_SMemRegion *r, size_t size)
+{
+    size_t step;
+
+    if (size <= r->committed)
+        return SCE_OK;
+    if (size > r->reserved) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        SCEE_LogMsg ("region too small: %zu bytes reserved, %zu asked",
+                     r->reserved, size);
+        return SCE_ERROR;
+    }
+    step = SCE_Mem_GetCommitStep (r);
+    size = (size + step - 1) & ~(step - 1);
+    if (size > r->reserved)
+        size = r->reserved;
+    if (mprotect (r->base + r->committed, size - r->committed,
+                  PROT_READ | PROT_WRITE) < 0) {
+        SCEE_LogErrno ("failed to commit memory");
+        return SCE_ERROR;
+    }
+    r->committed = size;
+    return SCE_OK;
+}
+
+/**
+ * \brief Gets the start of a region
+ */
+void* SCE_Mem_GetRegionData (const SCE_SMemRegion *r)
+{
+    return r->base;
+}
+/**
+ * \brief Gets the number of usable bytes of a region
+ */
+size_t SCE_Mem_GetRegionSize (const SCE_SMemRegion *r)
+{
+    return r->committed;
+}
+
 /** @} */
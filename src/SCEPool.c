@@ -0,0 +1,273 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEPool.h"
+
+/**
+ * \file SCEPool.c
+ * \copydoc pool
+ * \brief Fixed-size objects allocators
+ *
+ * \file SCEPool.h
+ * \copydoc pool
+ * \brief Fixed-size objects allocators
+ */
+
+/**
+ * \defgroup pool Fixed-size objects allocators
+ * \ingroup utils
+ * \brief Recycles objects of one size without going through SCE_malloc()
+ *
+ * A pool carves objects of one given size out of big slabs. Freed objects
+ * are linked together through their first bytes and handed out again by
+ * the next SCE_Pool_Alloc(), the slabs are only released by
+ * SCE_Pool_Clear(). Objects are aligned like pointers, or on 16 bytes when
+ * their size is a multiple of 16.
+ */
+
+/** @{ */
+
+/* size of a slab header, keeps the objects aligned on 16 bytes */
+#define SCE_POOL_SLAB_HEADER ((sizeof (SCE_SPoolSlab) + 15) & ~(size_t)15)
+
+#define SCE_Pool_GetObjects(s) ((unsigned char*)(s) + SCE_POOL_SLAB_HEADER)
+
+/**
+ * \brief Initializes a pool
+ * \param p the pool to initialize
+ * \param size size of the objects of the pool
+ *
+ * No memory is allocated until the first call to SCE_Pool_Alloc().
+ */
+void SCE_Pool_Init (SCE_SPool *p, size_t size)
+{
+    const size_t word = sizeof (void*);
+    if (size < word)
+        size = word;
+    p->obj_size = (size + word - 1) & ~(word - 1);
+    p->n_per_slab = 0;
+    SCE_Pool_SetSlabSize (p, SCE_POOL_SLAB_SIZE);
+    p->first = p->current = NULL;
+    p->n_taken = 0;
+    p->free = NULL;
+    p->n_used = 0;
+    p->tag = SCE_MEM_TAG_NONE;
+    p->safe = SCE_FALSE;
+    pthread_mutex_init (&p->mutex, NULL);
+}
+/**
+ * \brief Clears a pool, frees all its slabs
+ * \param p the pool to clear
+ *
+ * Every object of \p p becomes invalid. \p p stays usable, as if it had
+ * just been initialized with the same settings.
+ */
+void SCE_Pool_Clear (SCE_SPool *p)
+{
+    SCE_SPoolSlab *s = NULL, *next = NULL;
+    for (s = p->first; s; s = next) {
+        next = s->next;
+        SCE_free (s);
+    }
+    p->first = p->current = NULL;
+    p->n_taken = 0;
+    p->free = NULL;
+    p->n_used = 0;
+    /* reset for the next user of the pool, \p p must not be locked */
+    pthread_mutex_destroy (&p->mutex);
+    pthread_mutex_init (&p->mutex, NULL);
+}
+/**
+ * \brief Creates a new pool
+ * \param size size of the objects of the pool
+ * \returns a newly allocated pool, or NULL on error
+ */
+SCE_SPool* SCE_Pool_Create (size_t size)
+{
+    SCE_SPool *p = NULL;
+    if (!(p = SCE_malloc (sizeof *p)))
+        SCEE_LogSrc ();
+    else
+        SCE_Pool_Init (p, size);
+    return p;
+}
+/**
+ * \brief Deletes a pool
+ * \param p the pool to delete
+ */
+void SCE_Pool_Delete (SCE_SPool *p)
+{
+    if (p) {
+        SCE_Pool_Clear (p);
+        pthread_mutex_destroy (&p->mutex);
+        SCE_free (p);
+    }
+}
+
+/**
+ * \brief Makes a pool usable from several threads at once
+ * \param p a pool
+ * \param safe SCE_TRUE to lock \p p on each operation, default is SCE_FALSE
+ */
+void SCE_Pool_SetThreadSafe (SCE_SPool *p, int safe)
+{
+    p->safe = safe;
+}
+/**
+ * \brief Sets the size of the slabs of a pool
+ * \param p a pool
+ * \param size size in bytes of the slabs, default is SCE_POOL_SLAB_SIZE
+ *
+ * A slab always holds at least one object. The already allocated slabs of
+ * \p p keep their size, including those reused after SCE_Pool_FreeAll().
+ */
+void SCE_Pool_SetSlabSize (SCE_SPool *p, size_t size)
+{
+    p->n_per_slab = size / p->obj_size;
+    if (p->n_per_slab < 1)
+        p->n_per_slab = 1;
+}
+
+/**
+ * \brief Sets the memory tag the slabs of a pool are accounted to
+ * \param p a pool
+ * \param tag a memory tag, see SCE_Mem_AllocTagged()
+ */
+void SCE_Pool_SetTag (SCE_SPool *p, unsigned int tag)
+{
+    p->tag = tag;
+}
+
+static void* SCE_Pool_AllocUnlocked (SCE_SPool *p)
+{
+    void *obj = NULL;
+
+    if (p->free) {
+        obj = p->free;
+        p->free = *(void**)obj;
+    } else {
+        if (!p->current || p->n_taken == p->current->n_objects) {
+            SCE_SPoolSlab *s = NULL;
+            if (p->current && p->current->next) {
+                /* slabs left over by SCE_Pool_FreeAll() */
+                s = p->current->next;
+            } else {
+                s = SCE_malloc_tagged (p->tag, SCE_POOL_SLAB_HEADER +
+                                       p->n_per_slab * p->obj_size);
+                if (!s) {
+                    SCEE_LogSrc ();
+                    return NULL;
+                }
+                s->next = NULL;
+                s->n_objects = p->n_per_slab;
+                if (p->current)
+                    p->current->next = s;
+                else
+                    p->first = s;
+            }
+            p->current = s;
+            p->n_taken = 0;
+        }
+        obj = SCE_Pool_GetObjects (p->current) + p->n_taken * p->obj_size;
+        p->n_taken++;
+    }
+    p->n_used++;
+    return obj;
+}
+
+/**
+ * \brief Takes an object from a pool
+ * \param p a pool
+ * \returns an uninitialized object of the size given to SCE_Pool_Init(),
+ * or NULL on error
+ * \sa SCE_Pool_Free()
+ */
+void* SCE_Pool_Alloc (SCE_SPool *p)
+{
+    void *obj = NULL;
+    if (p->safe) {
+        pthread_mutex_lock (&p->mutex);
+        obj = SCE_Pool_AllocUnlocked (p);
+        pthread_mutex_unlock (&p->mutex);
+    } else
+        obj = SCE_Pool_AllocUnlocked (p);
+    return obj;
+}
+/**
+ * \brief Gives an object back to its pool
+ * \param p the pool \p obj was taken from
+ * \param obj the object to free, can be NULL
+ */
+void SCE_Pool_Free (SCE_SPool *p, void *obj)
+{
+    if (!obj)
+        return;
+    if (p->safe)
+        pthread_mutex_lock (&p->mutex);
+    *(void**)obj = p->free;
+    p->free = obj;
+    p->n_used--;
+    if (p->safe)
+        pthread_mutex_unlock (&p->mutex);
+}
+/**
+ * \brief Frees every object of a pool at once
+ * \param p a pool
+ *
+ * The slabs are kept and reused by the next calls to SCE_Pool_Alloc().
+ */
+void SCE_Pool_FreeAll (SCE_SPool *p)
+{
+    if (p->safe)
+        pthread_mutex_lock (&p->mutex);
+    p->current = p->first;
+    p->n_taken = 0;
+    p->free = NULL;
+    p->n_used = 0;
+    if (p->safe)
+        pthread_mutex_unlock (&p->mutex);
+}
+
+/**
+ * \brief Gets the size of the objects of a pool
+ * \param p a pool
+ * \returns the size of the objects, maybe rounded up from the size given to
+ * SCE_Pool_Init()
+ */
+size_t SCE_Pool_GetObjectSize (const SCE_SPool *p)
+{
+    return p->obj_size;
+}
+/**
+ * \brief Gets the number of objects in use in a pool
+ * \param p a pool
+ */
+size_t SCE_Pool_GetUsed (const SCE_SPool *p)
+{
+    return p->n_used;
+}
+
+/** @} */
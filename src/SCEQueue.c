@@ -0,0 +1,648 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEQueue.h"
+
+/**
+ * \file SCEQueue.c
+ * \copydoc queue
+ * \brief Lock-free queues
+ *
+ * \file SCEQueue.h
+ * \copydoc queue
+ * \brief Lock-free queues
+ */
+
+/**
+ * \defgroup queue Lock-free queues
+ * \ingroup utils
+ * \brief Queues shared by threads without locks
+ *
+ * SCE_SMPSCQueue is an intrusive queue: it links the SCE_SListIterator
+ * already embedded in the objects, so pushing allocates nothing. Any
+ * number of threads can push concurrently, a single thread pops. An
+ * iterator must not be in a list or another queue while it is queued, it
+ * can be attached to a list again once popped.
+ *
+ * This is the algorithm of Dmitry Vyukov: a push is one atomic exchange, a
+ * pop does not need any atomic read-modify-write.
+ *
+ * SCE_SSPSCRing and SCE_SMPMCRing are bounded ring buffers of pointers
+ * whose capacity is a power of two. Their push and pop indices sit on
+ * their own cache lines so that producers and consumers do not write to
+ * the same lines. The SPSC ring is wait-free: each side only writes its
+ * own index and caches the other one, reading it again only when the ring
+ * looks full or empty. The MPMC ring is the bounded queue of Dmitry
+ * Vyukov: every cell carries the ticket it is ready for, and threads claim
+ * tickets with a compare-and-swap on the index of their side.
+ *
+ * The batch functions move several items with a single update of the
+ * indices. With \c wait set they sleep on a condition variable when the
+ * ring is full (push) or empty (pop), a thread finishing a push or a pop
+ * only touches the mutex when somebody sleeps. SCE_SPSCRing_Close() and
+ * SCE_MPMCRing_Close() wake every sleeping thread for shutdown. NULL
+ * cannot be pushed in a ring.
+ */
+
+/** @{ */
+
+/**
+ * \brief Initializes a queue
+ * \param q the queue to initialize
+ */
+void SCE_MPSCQueue_Init (SCE_SMPSCQueue *q)
+{
+    SCE_List_InitIt (&q->stub);
+    q->head = q->tail = &q->stub;
+}
+
+/**
+ * \brief Adds an iterator to a queue, can be called from any thread
+ * \param q a queue
+ * \param it the iterator to add, its \c prev and \c next are overwritten
+ */
+void SCE_MPSCQueue_Push (SCE_SMPSCQueue *q, SCE_SListIterator *it)
+{
+    SCE_SListIterator *prev = NULL;
+
+    it->prev = NULL;
+    __atomic_store_n (&it->next, NULL, __ATOMIC_RELAXED);
+    prev = __atomic_exchange_n (&q->head, it, __ATOMIC_ACQ_REL);
+    /* until this store the consumer sees the queue ending at prev */
+    __atomic_store_n (&prev->next, it, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief Removes the oldest iterator of a queue, consumer thread only
+ * \param q a queue
+ * \returns the removed iterator, or NULL if the queue is empty or if the
+ * oldest push has not completed yet
+ */
+SCE_SListIterator* SCE_MPSCQueue_Pop (SCE_SMPSCQueue *q)
+{
+    SCE_SListIterator *tail = q->tail;
+    SCE_SListIterator *next = __atomic_load_n (&tail->next, __ATOMIC_ACQUIRE);
+
+    if (tail == &q->stub) {
+        if (!next)
+            return NULL;
+        q->tail = tail = next;
+        next = __atomic_load_n (&tail->next, __ATOMIC_ACQUIRE);
+    }
+    if (!next) {
+        /* tail may be the last iterator: the stub is pushed back behind it
+           so that tail can be unlinked */
+        if (tail != __atomic_load_n (&q->head, __ATOMIC_ACQUIRE))
+            return NULL;        /* a producer is between its two steps */
+        SCE_MPSCQueue_Push (q, &q->stub);
+        next = __atomic_load_n (&tail->next, __ATOMIC_ACQUIRE);
+        if (!next)
+            return NULL;
+    }
+    q->tail = next;
+    tail->next = NULL;
+    return tail;
+}
+
+/**
+ * \brief Moves all the iterators of a queue at the end of a list, consumer
+ * thread only
+ * \param q a queue
+ * \param l the list receiving the iterators
+ * \returns the number of moved iterators
+ * \sa SCE_MPSCQueue_Pop()
+ */
+unsigned int SCE_MPSCQueue_Drain (SCE_SMPSCQueue *q, SCE_SList *l)
+{
+    SCE_SListIterator *it = NULL;
+    unsigned int n = 0;
+
+    while ((it = SCE_MPSCQueue_Pop (q))) {
+        SCE_List_Appendl (l, it);
+        n++;
+    }
+    return n;
+}
+
+/**
+ * \brief Is a queue empty? Consumer thread only
+ */
+int SCE_MPSCQueue_IsEmpty (SCE_SMPSCQueue *q)
+{
+    SCE_SListIterator *tail = q->tail;
+    if (tail == &q->stub)
+        return !__atomic_load_n (&tail->next, __ATOMIC_ACQUIRE);
+    return SCE_FALSE;
+}
+
+/* number of failed attempts before a blocking call goes to sleep */
+#define SCE_RING_SPINS 64
+
+static void SCE_Ring_InitWait (SCE_SRingWait *w)
+{
+    w->waiters = 0;
+    w->closed = SCE_FALSE;
+    pthread_mutex_init (&w->mutex, NULL);
+    pthread_cond_init (&w->cond, NULL);
+}
+static void SCE_Ring_ClearWait (SCE_SRingWait *w)
+{
+    pthread_cond_destroy (&w->cond);
+    pthread_mutex_destroy (&w->mutex);
+}
+/* called after the indices of a ring changed: wakes sleeping threads */
+static void SCE_Ring_Notify (SCE_SRingWait *w)
+{
+    /* pairs with the increment of waiters in SCE_Ring_Sleep(): either the
+       sleeper sees the new index or we see it waiting */
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    if (__atomic_load_n (&w->waiters, __ATOMIC_RELAXED)) {
+        pthread_mutex_lock (&w->mutex);
+        /* woken threads do not decrement waiters themselves, otherwise
+           every push or pop would broadcast until they get to run */
+        if (w->waiters) {
+            __atomic_store_n (&w->waiters, 0, __ATOMIC_RELAXED);
+            pthread_cond_broadcast (&w->cond);
+        }
+        pthread_mutex_unlock (&w->mutex);
+    }
+}
+/* sleeps until blocked (ring) returns false or the ring is closed */
+static void SCE_Ring_Sleep (SCE_SRingWait *w, int (*blocked)(void*),
+                            void *ring)
+{
+    pthread_mutex_lock (&w->mutex);
+    __atomic_add_fetch (&w->waiters, 1, __ATOMIC_SEQ_CST);
+    if (blocked (ring) && !__atomic_load_n (&w->closed, __ATOMIC_ACQUIRE))
+        pthread_cond_wait (&w->cond, &w->mutex);
+    else
+        __atomic_sub_fetch (&w->waiters, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock (&w->mutex);
+}
+static void SCE_Ring_Close (SCE_SRingWait *w)
+{
+    pthread_mutex_lock (&w->mutex);
+    __atomic_store_n (&w->closed, SCE_TRUE, __ATOMIC_RELEASE);
+    pthread_cond_broadcast (&w->cond);
+    pthread_mutex_unlock (&w->mutex);
+}
+/* pushes or pops items without blocking, returns how many were moved */
+typedef size_t (*SCE_FRingMove)(void*, void**, size_t);
+
+/* moves items with move () until all n are moved if all is true, or one
+   is moved, or the ring is closed */
+static size_t SCE_Ring_Wait (SCE_SRingWait *w, SCE_FRingMove move,
+                             int (*blocked)(void*), void *ring, void **items,
+                             size_t n, int all)
+{
+    size_t done = 0;
+    unsigned int spins = 0;
+
+    for (;;) {
+        done += move (ring, &items[done], n - done);
+        if (done == n || (done && !all) ||
+            __atomic_load_n (&w->closed, __ATOMIC_ACQUIRE))
+            return done;
+        if (++spins >= SCE_RING_SPINS)
+            SCE_Ring_Sleep (w, blocked, ring);
+    }
+}
+
+/* rounds a capacity up to a power of two, at least 2 */
+static size_t SCE_Ring_Capacity (size_t capacity)
+{
+    size_t n = 2;
+    while (n < capacity)
+        n *= 2;
+    return n;
+}
+
+
+/**
+ * \brief Initializes a SPSC ring buffer
+ * \param r the ring to initialize
+ * \param capacity maximum number of items, rounded up to a power of two
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_SPSCRing_Init (SCE_SSPSCRing *r, size_t capacity)
+{
+    capacity = SCE_Ring_Capacity (capacity);
+    r->head = r->tail_cache = 0;
+    r->tail = r->head_cache = 0;
+    r->mask = capacity - 1;
+    SCE_Ring_InitWait (&r->wait);
+    if (!(r->slots = SCE_malloc (capacity * sizeof *r->slots))) {
+        SCE_Ring_ClearWait (&r->wait);
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Clears a SPSC ring buffer, the items it holds are forgotten
+ */
+void SCE_SPSCRing_Clear (SCE_SSPSCRing *r)
+{
+    SCE_free (r->slots);
+    r->slots = NULL;
+    SCE_Ring_ClearWait (&r->wait);
+}
+/**
+ * \brief Creates a SPSC ring buffer
+ * \sa SCE_SPSCRing_Init()
+ */
+SCE_SSPSCRing* SCE_SPSCRing_Create (size_t capacity)
+{
+    SCE_SSPSCRing *r = NULL;
+    if (!(r = SCE_malloc_aligned (SCE_CACHE_LINE_SIZE, sizeof *r)))
+        goto fail;
+    if (SCE_SPSCRing_Init (r, capacity) < 0) {
+        SCE_free_aligned (r);
+        goto fail;
+    }
+    return r;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+/**
+ * \brief Deletes a SPSC ring buffer created by SCE_SPSCRing_Create()
+ */
+void SCE_SPSCRing_Delete (SCE_SSPSCRing *r)
+{
+    if (r) {
+        SCE_SPSCRing_Clear (r);
+        SCE_free_aligned (r);
+    }
+}
+
+static size_t SCE_SPSCRing_TryPush (void *ring, void **items, size_t n)
+{
+    SCE_SSPSCRing *r = ring;
+    size_t i, head = r->head, capacity = r->mask + 1;
+
+    if (capacity - (head - r->tail_cache) < n)
+        r->tail_cache = __atomic_load_n (&r->tail, __ATOMIC_ACQUIRE);
+    if (n > capacity - (head - r->tail_cache))
+        n = capacity - (head - r->tail_cache);
+    if (!n)
+        return 0;
+    for (i = 0; i < n; i++)
+        r->slots[(head + i) & r->mask] = items[i];
+    __atomic_store_n (&r->head, head + n, __ATOMIC_RELEASE);
+    SCE_Ring_Notify (&r->wait);
+    return n;
+}
+static size_t SCE_SPSCRing_TryPop (void *ring, void **items, size_t n)
+{
+    SCE_SSPSCRing *r = ring;
+    size_t i, tail = r->tail;
+
+    if (r->head_cache - tail < n)
+        r->head_cache = __atomic_load_n (&r->head, __ATOMIC_ACQUIRE);
+    if (n > r->head_cache - tail)
+        n = r->head_cache - tail;
+    if (!n)
+        return 0;
+    for (i = 0; i < n; i++)
+        items[i] = r->slots[(tail + i) & r->mask];
+    __atomic_store_n (&r->tail, tail + n, __ATOMIC_RELEASE);
+    SCE_Ring_Notify (&r->wait);
+    return n;
+}
+static int SCE_SPSCRing_IsFull (void *ring)
+{
+    SCE_SSPSCRing *r = ring;
+    return __atomic_load_n (&r->tail, __ATOMIC_SEQ_CST) + r->mask + 1 ==
+        r->head;
+}
+static int SCE_SPSCRing_IsEmpty (void *ring)
+{
+    SCE_SSPSCRing *r = ring;
+    return __atomic_load_n (&r->head, __ATOMIC_SEQ_CST) == r->tail;
+}
+
+/**
+ * \brief Adds an item to a SPSC ring buffer, producer thread only
+ * \param r a ring
+ * \param item the item, not NULL
+ * \returns SCE_TRUE if \p item was added, SCE_FALSE if \p r is full
+ */
+int SCE_SPSCRing_Push (SCE_SSPSCRing *r, void *item)
+{
+    return SCE_SPSCRing_TryPush (r, &item, 1) ? SCE_TRUE : SCE_FALSE;
+}
+/**
+ * \brief Removes the oldest item of a SPSC ring buffer, consumer thread
+ * only
+ * \param r a ring
+ * \returns the item, or NULL if \p r is empty
+ */
+void* SCE_SPSCRing_Pop (SCE_SSPSCRing *r)
+{
+    void *item = NULL;
+    SCE_SPSCRing_TryPop (r, &item, 1);
+    return item;
+}
+/**
+ * \brief Adds several items to a SPSC ring buffer, producer thread only
+ * \param r a ring
+ * \param items the items, in order
+ * \param n number of items in \p items
+ * \param wait if SCE_TRUE, sleeps while \p r is full until all the items
+ * are added or \p r is closed
+ * \returns the number of items added, the first ones of \p items
+ */
+size_t SCE_SPSCRing_PushN (SCE_SSPSCRing *r, void **items, size_t n,
+                           int wait)
+{
+    if (!wait)
+        return SCE_SPSCRing_TryPush (r, items, n);
+    return SCE_Ring_Wait (&r->wait, SCE_SPSCRing_TryPush, SCE_SPSCRing_IsFull,
+                          r, items, n, SCE_TRUE);
+}
+/**
+ * \brief Removes several items from a SPSC ring buffer, consumer thread
+ * only
+ * \param r a ring
+ * \param items receives the items, oldest first
+ * \param n maximum number of items to remove
+ * \param wait if SCE_TRUE, sleeps while \p r is empty until at least one
+ * item is removed or \p r is closed
+ * \returns the number of items removed, 0 when \p r is empty (and closed
+ * if \p wait is SCE_TRUE)
+ */
+size_t SCE_SPSCRing_PopN (SCE_SSPSCRing *r, void **items, size_t n, int wait)
+{
+    if (!wait)
+        return SCE_SPSCRing_TryPop (r, items, n);
+    return SCE_Ring_Wait (&r->wait, SCE_SPSCRing_TryPop, SCE_SPSCRing_IsEmpty,
+                          r, items, n, SCE_FALSE);
+}
+/**
+ * \brief Wakes up the threads sleeping on a SPSC ring buffer for good
+ *
+ * Blocking calls return instead of waiting from now on. The items still in
+ * \p r can be popped.
+ */
+void SCE_SPSCRing_Close (SCE_SSPSCRing *r)
+{
+    SCE_Ring_Close (&r->wait);
+}
+/**
+ * \brief Gets the number of items in a SPSC ring buffer, may be outdated
+ * when it returns
+ */
+size_t SCE_SPSCRing_GetSize (SCE_SSPSCRing *r)
+{
+    size_t tail = __atomic_load_n (&r->tail, __ATOMIC_ACQUIRE);
+    return __atomic_load_n (&r->head, __ATOMIC_ACQUIRE) - tail;
+}
+size_t SCE_SPSCRing_GetCapacity (const SCE_SSPSCRing *r)
+{
+    return r->mask + 1;
+}
+
+
+/**
+ * \brief Initializes a MPMC ring buffer
+ * \param r the ring to initialize
+ * \param capacity maximum number of items, rounded up to a power of two
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_MPMCRing_Init (SCE_SMPMCRing *r, size_t capacity)
+{
+    size_t i;
+
+    capacity = SCE_Ring_Capacity (capacity);
+    r->head = r->tail = 0;
+    r->mask = capacity - 1;
+    SCE_Ring_InitWait (&r->wait);
+    if (!(r->cells = SCE_malloc (capacity * sizeof *r->cells))) {
+        SCE_Ring_ClearWait (&r->wait);
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    for (i = 0; i < capacity; i++) {
+        r->cells[i].seq = i;
+        r->cells[i].data = NULL;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Clears a MPMC ring buffer, the items it holds are forgotten
+ */
+void SCE_MPMCRing_Clear (SCE_SMPMCRing *r)
+{
+    SCE_free (r->cells);
+    r->cells = NULL;
+    SCE_Ring_ClearWait (&r->wait);
+}
+/**
+ * \brief Creates a MPMC ring buffer
+ * \sa SCE_MPMCRing_Init()
+ */
+SCE_SMPMCRing* SCE_MPMCRing_Create (size_t capacity)
+{
+    SCE_SMPMCRing *r = NULL;
+    if (!(r = SCE_malloc_aligned (SCE_CACHE_LINE_SIZE, sizeof *r)))
+        goto fail;
+    if (SCE_MPMCRing_Init (r, capacity) < 0) {
+        SCE_free_aligned (r);
+        goto fail;
+    }
+    return r;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+/**
+ * \brief Deletes a MPMC ring buffer created by SCE_MPMCRing_Create()
+ */
+void SCE_MPMCRing_Delete (SCE_SMPMCRing *r)
+{
+    if (r) {
+        SCE_MPMCRing_Clear (r);
+        SCE_free_aligned (r);
+    }
+}
+
+/* claims up to n consecutive tickets of *index whose cells have a sequence
+   of ticket + offset, returns how many were claimed from *first */
+static size_t SCE_MPMCRing_Claim (SCE_SMPMCRing *r, size_t *index,
+                                  size_t offset, size_t n, size_t *first)
+{
+    size_t pos = __atomic_load_n (index, __ATOMIC_RELAXED);
+
+    for (;;) {
+        size_t k = 0;
+        while (k < n && k <= r->mask) {
+            SCE_SRingCell *c = &r->cells[(pos + k) & r->mask];
+            if (__atomic_load_n (&c->seq, __ATOMIC_ACQUIRE) != pos + k + offset)
+                break;
+            k++;
+        }
+        if (!k) {
+            size_t now = __atomic_load_n (index, __ATOMIC_RELAXED);
+            if (now == pos)
+                return 0;       /* full or empty */
+            pos = now;
+            continue;
+        }
+        /* cells ready for tickets we do not own yet can only be taken by
+           the owner of those tickets, hence the check above stays true */
+        if (__atomic_compare_exchange_n (index, &pos, pos + k, SCE_TRUE,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *first = pos;
+            return k;
+        }
+    }
+}
+static size_t SCE_MPMCRing_TryPush (void *ring, void **items, size_t n)
+{
+    SCE_SMPMCRing *r = ring;
+    size_t i, pos, k = SCE_MPMCRing_Claim (r, &r->head, 0, n, &pos);
+
+    for (i = 0; i < k; i++) {
+        SCE_SRingCell *c = &r->cells[(pos + i) & r->mask];
+        c->data = items[i];
+        __atomic_store_n (&c->seq, pos + i + 1, __ATOMIC_RELEASE);
+    }
+    if (k)
+        SCE_Ring_Notify (&r->wait);
+    return k;
+}
+static size_t SCE_MPMCRing_TryPop (void *ring, void **items, size_t n)
+{
+    SCE_SMPMCRing *r = ring;
+    size_t i, pos, k = SCE_MPMCRing_Claim (r, &r->tail, 1, n, &pos);
+
+    for (i = 0; i < k; i++) {
+        SCE_SRingCell *c = &r->cells[(pos + i) & r->mask];
+        items[i] = c->data;
+        __atomic_store_n (&c->seq, pos + i + r->mask + 1, __ATOMIC_RELEASE);
+    }
+    if (k)
+        SCE_Ring_Notify (&r->wait);
+    return k;
+}
+static int SCE_MPMCRing_IsFull (void *ring)
+{
+    SCE_SMPMCRing *r = ring;
+    size_t pos = __atomic_load_n (&r->head, __ATOMIC_SEQ_CST);
+    return __atomic_load_n (&r->cells[pos & r->mask].seq, __ATOMIC_SEQ_CST)
+        != pos;
+}
+static int SCE_MPMCRing_IsEmpty (void *ring)
+{
+    SCE_SMPMCRing *r = ring;
+    size_t pos = __atomic_load_n (&r->tail, __ATOMIC_SEQ_CST);
+    return __atomic_load_n (&r->cells[pos & r->mask].seq, __ATOMIC_SEQ_CST)
+        != pos + 1;
+}
+
+/**
+ * \brief Adds an item to a MPMC ring buffer, can be called from any thread
+ * \param r a ring
+ * \param item the item, not NULL
+ * \returns SCE_TRUE if \p item was added, SCE_FALSE if \p r is full
+ */
+int SCE_MPMCRing_Push (SCE_SMPMCRing *r, void *item)
+{
+    return SCE_MPMCRing_TryPush (r, &item, 1) ? SCE_TRUE : SCE_FALSE;
+}
+/**
+ * \brief Removes the oldest item of a MPMC ring buffer, can be called from
+ * any thread
+ * \param r a ring
+ * \returns the item, or NULL if \p r is empty
+ */
+void* SCE_MPMCRing_Pop (SCE_SMPMCRing *r)
+{
+    void *item = NULL;
+    SCE_MPMCRing_TryPop (r, &item, 1);
+    return item;
+}
+/**
+ * \brief Adds several items to a MPMC ring buffer
+ * \param r a ring
+ * \param items the items, in order
+ * \param n number of items in \p items
+ * \param wait if SCE_TRUE, sleeps while \p r is full until all the items
+ * are added or \p r is closed
+ * \returns the number of items added, the first ones of \p items
+ *
+ * The items added by one call are consecutive in \p r unless \p r fills
+ * up, then items of other producers can come in between.
+ */
+size_t SCE_MPMCRing_PushN (SCE_SMPMCRing *r, void **items, size_t n,
+                           int wait)
+{
+    if (!wait)
+        return SCE_MPMCRing_TryPush (r, items, n);
+    return SCE_Ring_Wait (&r->wait, SCE_MPMCRing_TryPush, SCE_MPMCRing_IsFull,
+                          r, items, n, SCE_TRUE);
+}
+/**
+ * \brief Removes several items from a MPMC ring buffer
+ * \param r a ring
+ * \param items receives the items, oldest first
+ * \param n maximum number of items to remove
+ * \param wait if SCE_TRUE, sleeps while \p r is empty until at least one
+ * item is removed or \p r is closed
+ * \returns the number of items removed, 0 when \p r is empty (and closed
+ * if \p wait is SCE_TRUE)
+ */
+size_t SCE_MPMCRing_PopN (SCE_SMPMCRing *r, void **items, size_t n, int wait)
+{
+    if (!wait)
+        return SCE_MPMCRing_TryPop (r, items, n);
+    return SCE_Ring_Wait (&r->wait, SCE_MPMCRing_TryPop, SCE_MPMCRing_IsEmpty,
+                          r, items, n, SCE_FALSE);
+}
+/**
+ * \brief Wakes up the threads sleeping on a MPMC ring buffer for good
+ * \sa SCE_SPSCRing_Close()
+ */
+void SCE_MPMCRing_Close (SCE_SMPMCRing *r)
+{
+    SCE_Ring_Close (&r->wait);
+}
+/**
+ * \brief Gets the number of items in a MPMC ring buffer, may be outdated
+ * when it returns
+ */
+size_t SCE_MPMCRing_GetSize (SCE_SMPMCRing *r)
+{
+    size_t tail = __atomic_load_n (&r->tail, __ATOMIC_ACQUIRE);
+    size_t head = __atomic_load_n (&r->head, __ATOMIC_ACQUIRE);
+    return head > tail ? head - tail : 0;
+}
+size_t SCE_MPMCRing_GetCapacity (const SCE_SMPMCRing *r)
+{
+    return r->mask + 1;
+}
+
+/** @} */
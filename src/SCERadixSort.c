@@ -0,0 +1,279 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEWorkers.h"
+#include "SCE/utils/SCERadixSort.h"
+
+/**
+ * \file SCERadixSort.c
+ * \copydoc radixsort
+ * \brief Radix sorts
+ *
+ * \file SCERadixSort.h
+ * \copydoc radixsort
+ * \brief Radix sorts
+ */
+
+/**
+ * \defgroup radixsort Radix sorts
+ * \ingroup utils
+ * \brief Sorting by integer keys without comparisons
+ *
+ * Instead of calling a comparison function O(n log n) times, the key of
+ * each element is computed once and the elements are sorted by the bytes
+ * of their keys, least significant first, in one pass per byte. The sorts
+ * are stable and O(n). Passes where all the keys share the same byte are
+ * skipped, so small ranges of keys sort faster.
+ *
+ * The keys are unsigned, signed integers and floating point numbers are
+ * converted by SCE_Radix_IntKey(), SCE_Radix_FloatKey()... which keep their
+ * order.
+ */
+
+/** @{ */
+
+#define SCE_RADIX_BITS 8
+#define SCE_RADIX_SIZE (1 << SCE_RADIX_BITS)
+
+/**
+ * \brief Gets the sort key of a signed integer
+ */
+uint32_t SCE_Radix_IntKey (int32_t a)
+{
+    return (uint32_t)a ^ 0x80000000u;
+}
+/**
+ * \brief Gets the sort key of a float
+ *
+ * Negative numbers are sorted before positive ones, -0 before +0 and NaNs
+ * at both ends depending on their sign.
+ */
+uint32_t SCE_Radix_FloatKey (float a)
+{
+    uint32_t u;
+    memcpy (&u, &a, sizeof u);
+    return u & 0x80000000u ? ~u : u | 0x80000000u;
+}
+/**
+ * \brief Gets the sort key of a 64 bits signed integer
+ */
+uint64_t SCE_Radix_Int64Key (int64_t a)
+{
+    return (uint64_t)a ^ 0x8000000000000000ULL;
+}
+/**
+ * \brief Gets the sort key of a double
+ * \sa SCE_Radix_FloatKey()
+ */
+uint64_t SCE_Radix_DoubleKey (double a)
+{
+    uint64_t u;
+    memcpy (&u, &a, sizeof u);
+    return u & 0x8000000000000000ULL ? ~u : u | 0x8000000000000000ULL;
+}
+
+/* generates the sorts of SCE_SSortKey<bits> arrays and of lists, wrapped
+   by the public functions below */
+#define SCE_Radix_SortFuncs(bits)                                           \
+typedef struct {                                                            \
+    const SCE_SSortKey##bits *items;                                        \
+    size_t n;                                                               \
+    size_t (*hists)[bits / SCE_RADIX_BITS][SCE_RADIX_SIZE];                 \
+    unsigned int n_tasks;                                                   \
+} SCE_SRadixHist##bits;                                                     \
+                                                                            \
+static void SCE_Radix_Histogram##bits (const SCE_SSortKey##bits *items,     \
+                                       size_t n, size_t (*h)[SCE_RADIX_SIZE])\
+{                                                                           \
+    size_t i;                                                               \
+    unsigned int d;                                                         \
+    for (i = 0; i < n; i++) {                                               \
+        uint##bits##_t k = items[i].key;                                    \
+        for (d = 0; d < bits / SCE_RADIX_BITS; d++)                         \
+            h[d][(k >> (d * SCE_RADIX_BITS)) & (SCE_RADIX_SIZE - 1)]++;     \
+    }                                                                       \
+}                                                                           \
+static void SCE_Radix_HistogramTask##bits (unsigned int i, void *data)      \
+{                                                                           \
+    SCE_SRadixHist##bits *p = data;                                         \
+    size_t start = p->n * i / p->n_tasks;                                   \
+    size_t end = p->n * (i + 1) / p->n_tasks;                               \
+    SCE_Radix_Histogram##bits (&p->items[start], end - start, p->hists[i]); \
+}                                                                           \
+                                                                            \
+/* computes the histograms of all the digits in one pass, on the worker     \
+   threads for large arrays */                                              \
+static void SCE_Radix_Histograms##bits (const SCE_SSortKey##bits *items,    \
+                                        size_t n,                           \
+                                        size_t (*h)[SCE_RADIX_SIZE])        \
+{                                                                           \
+    SCE_SRadixHist##bits p;                                                 \
+    unsigned int i, d, j;                                                   \
+                                                                            \
+    memset (h, 0, bits / SCE_RADIX_BITS * sizeof *h);                       \
+    p.n_tasks = n < SCE_RADIX_PARALLEL_MIN ? 1 : SCE_Workers_GetCount ();   \
+    p.hists = NULL;                                                         \
+    if (p.n_tasks > 1 &&                                                    \
+        !(p.hists = SCE_calloc (p.n_tasks, sizeof *p.hists)))               \
+        SCEE_Clear ();          /* not fatal, done on this thread */        \
+    if (p.hists) {                                                          \
+        p.items = items;                                                    \
+        p.n = n;                                                            \
+        SCE_Workers_Run (p.n_tasks, SCE_Radix_HistogramTask##bits, &p);     \
+        for (i = 0; i < p.n_tasks; i++) {                                   \
+            for (d = 0; d < bits / SCE_RADIX_BITS; d++) {                   \
+                for (j = 0; j < SCE_RADIX_SIZE; j++)                        \
+                    h[d][j] += p.hists[i][d][j];                            \
+            }                                                               \
+        }                                                                   \
+        SCE_free (p.hists);                                                 \
+    } else                                                                  \
+        SCE_Radix_Histogram##bits (items, n, h);                            \
+}                                                                           \
+                                                                            \
+static int SCE_Radix_DoSort##bits (SCE_SSortKey##bits *items, size_t n,     \
+                                   SCE_SSortKey##bits *tmp)                 \
+{                                                                           \
+    size_t h[bits / SCE_RADIX_BITS][SCE_RADIX_SIZE];                        \
+    SCE_SSortKey##bits *src = items, *dst = tmp, *swap = NULL;              \
+    unsigned int d, j;                                                      \
+    size_t i;                                                               \
+                                                                            \
+    if (n < 2)                                                              \
+        return SCE_OK;                                                      \
+    if (!tmp && !(dst = SCE_malloc (n * sizeof *dst))) {                    \
+        SCEE_LogSrc ();                                                     \
+        return SCE_ERROR;                                                   \
+    }                                                                       \
+    SCE_Radix_Histograms##bits (items, n, h);                               \
+    for (d = 0; d < bits / SCE_RADIX_BITS; d++) {                           \
+        unsigned int shift = d * SCE_RADIX_BITS;                            \
+        size_t offset = 0;                                                  \
+        if (h[d][(items[0].key >> shift) & (SCE_RADIX_SIZE - 1)] == n)      \
+            continue;           /* same digit everywhere */                 \
+        for (j = 0; j < SCE_RADIX_SIZE; j++) {                              \
+            size_t c = h[d][j];                                             \
+            h[d][j] = offset;                                               \
+            offset += c;                                                    \
+        }                                                                   \
+        for (i = 0; i < n; i++)                                             \
+            dst[h[d][(src[i].key >> shift) & (SCE_RADIX_SIZE - 1)]++] =     \
+                src[i];                                                     \
+        swap = src;                                                         \
+        src = dst;                                                          \
+        dst = swap;                                                         \
+    }                                                                       \
+    if (src != items)                                                       \
+        memcpy (items, src, n * sizeof *items);                             \
+    if (!tmp)                                                               \
+        SCE_free (src == items ? dst : src);                                \
+    return SCE_OK;                                                          \
+}                                                                           \
+                                                                            \
+static int SCE_Radix_DoSortList##bits (SCE_SList *l,                       \
+                                       SCE_FRadixKey##bits f)               \
+{                                                                           \
+    SCE_SSortKey##bits *items = NULL;                                       \
+    SCE_SListIterator *it = NULL;                                           \
+    size_t i = 0, n = 0;                                                    \
+                                                                            \
+    /* counts the elements the loop below visits */                         \
+    SCE_List_ForEach (it, l)                                                \
+        n++;                                                                \
+    if (n < 2)                                                              \
+        return SCE_OK;                                                      \
+    if (!(items = SCE_malloc (2 * n * sizeof *items))) {                    \
+        SCEE_LogSrc ();                                                     \
+        return SCE_ERROR;                                                   \
+    }                                                                       \
+    SCE_List_ForEach (it, l) {                                              \
+        items[i].key = f (it->data);                                        \
+        items[i].data = it;                                                 \
+        i++;                                                                \
+    }                                                                       \
+    SCE_Radix_DoSort##bits (items, n, &items[n]);                           \
+    SCE_List_Flush (l);                                                     \
+    for (i = 0; i < n; i++)                                                 \
+        SCE_List_Appendl (l, items[i].data);                                \
+    SCE_free (items);                                                       \
+    return SCE_OK;                                                          \
+}
+
+SCE_Radix_SortFuncs (32)
+SCE_Radix_SortFuncs (64)
+
+/**
+ * \brief Sorts an array by increasing 32 bits keys
+ * \param items the elements to sort
+ * \param n number of elements
+ * \param tmp array of \p n elements used by the sort, can be NULL
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ * \sa SCE_Radix_Sort64(), SCE_Radix_SortList32()
+ */
+int SCE_Radix_Sort32 (SCE_SSortKey32 *items, size_t n, SCE_SSortKey32 *tmp)
+{
+    return SCE_Radix_DoSort32 (items, n, tmp);
+}
+/**
+ * \brief Sorts an array by increasing 64 bits keys
+ * \param items the elements to sort
+ * \param n number of elements
+ * \param tmp array of \p n elements used by the sort, can be NULL
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ * \sa SCE_Radix_Sort32(), SCE_Radix_SortList64()
+ */
+int SCE_Radix_Sort64 (SCE_SSortKey64 *items, size_t n, SCE_SSortKey64 *tmp)
+{
+    return SCE_Radix_DoSort64 (items, n, tmp);
+}
+
+/**
+ * \brief Sorts a list by increasing 32 bits keys
+ * \param l a list, not joined to other lists
+ * \param f returns the key of the data of an element
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * \p f is called once per element, the iterators are then relinked in
+ * order. The sort is stable.
+ * \sa SCE_Radix_SortList64(), SCE_List_MergeSort()
+ */
+int SCE_Radix_SortList32 (SCE_SList *l, SCE_FRadixKey32 f)
+{
+    return SCE_Radix_DoSortList32 (l, f);
+}
+/**
+ * \brief Sorts a list by increasing 64 bits keys
+ * \param l a list, not joined to other lists
+ * \param f returns the key of the data of an element
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ * \sa SCE_Radix_SortList32()
+ */
+int SCE_Radix_SortList64 (SCE_SList *l, SCE_FRadixKey64 f)
+{
+    return SCE_Radix_DoSortList64 (l, f);
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 02/01/2007
-   updated: 31/08/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -26,6 +26,7 @@
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEString.h"
 #include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEPool.h"
 #include "SCE/utils/SCEMedia.h"
 #include "SCE/utils/SCEResource.h"
 
@@ -72,6 +73,7 @@ struct sce_sresource
 
 static SCE_SList resources_type;
 static SCE_SList resources;
+static SCE_SPool resources_pool; /* records of the resources */
 
 static int res_type_id = 0;     /* type 0 is unused */
 
@@ -88,7 +90,7 @@ static void SCE_Resource_InitType (SCE_SResourceType *r)
 static SCE_SResourceType* SCE_Resource_CreateType (void)
 {
     SCE_SResourceType *res = NULL;
-    if (!(res = SCE_malloc (sizeof *res)))
+    if (!(res = SCE_malloc_tagged (SCE_MEM_TAG_RESOURCE, sizeof *res)))
         SCEE_LogSrc ();
     else
         SCE_Resource_InitType (res);
@@ -114,7 +116,7 @@ static void SCE_Resource_Init (SCE_SResource *r)
 static SCE_SResource* SCE_Resource_Create (void)
 {
     SCE_SResource *res = NULL;
-    res = SCE_malloc (sizeof *res);
+    res = SCE_Pool_Alloc (&resources_pool);
     if (!res)
         SCEE_LogSrc ();
     else
@@ -126,7 +128,7 @@ static void SCE_Resource_Delete (void *r)
     if (r) {
         SCE_SResource *res = r;
         SCE_free (res->name);
-        SCE_free (res);
+        SCE_Pool_Free (&resources_pool, res);
     }
 }
 
@@ -139,6 +141,8 @@ static void SCE_Resource_Delete (void *r)
 int SCE_Init_Resource (void)
 {
     res_type_id = 0;
+    SCE_Pool_Init (&resources_pool, sizeof (SCE_SResource));
+    SCE_Pool_SetTag (&resources_pool, SCE_MEM_TAG_RESOURCE);
     SCE_List_Init (&resources);
     SCE_List_SetFreeFunc (&resources, SCE_Resource_Delete);
     SCE_List_Init (&resources_type);
@@ -152,6 +156,7 @@ void SCE_Quit_Resource (void)
 {
     SCE_List_Clear (&resources);
     SCE_List_Clear (&resources_type);
+    SCE_Pool_Clear (&resources_pool);
     res_type_id = 0;
 }
 
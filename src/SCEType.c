@@ -17,13 +17,18 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/04/2010
-   updated: 23/01/2012 */
+   updated: 18/10/2026 */
 
 #include <string.h>
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEJobs.h"
 #include "SCE/utils/SCEType.h"
 
+/* number of elements from which conversions run on the job system, and
+   size of the parts */
+#define SCE_TYPE_PARALLEL_MIN (1 << 16)
+
 static const size_t type_sizes[SCE_NUM_TYPES] = {
     0,
     sizeof (SCEbyte),
@@ -68,19 +73,9 @@ size_t SCE_Type_Sizeof (SCE_EType type)
     return type_sizes[type];
 }
 
-
-/**
- * \brief Converts data from one to another type
- * \param tdest destination data type
- * \param dest destination data pointer (must be already allocated)
- * \param tsrc source data type
- * \param src source data pointer
- * \param n number of elements in \p src (not bytes, just the number of typed
- * values)
- * \sa SCE_Type_ConvertDup()
- */
-void SCE_Type_Convert (int tdest, void *dest, int tsrc,
-                       const void *src, size_t n)
+/* converts n elements on the calling thread */
+static void SCE_Type_ConvertPart (int tdest, void *dest, int tsrc,
+                                  const void *src, size_t n)
 {
     union SCE_UType {
         SCEubyte *ub;
@@ -138,6 +133,51 @@ void SCE_Type_Convert (int tdest, void *dest, int tsrc,
     }
 }
 
+typedef struct sce_stypeconversion SCE_STypeConversion;
+struct sce_stypeconversion {
+    int tdest, tsrc;
+    unsigned char *dest;
+    const unsigned char *src;
+};
+
+static void SCE_Type_ConvertRange (size_t begin, size_t end, void *data)
+{
+    SCE_STypeConversion *c = data;
+    SCE_Type_ConvertPart (c->tdest,
+                          &c->dest[begin * SCE_Type_Sizeof (c->tdest)],
+                          c->tsrc, &c->src[begin * SCE_Type_Sizeof (c->tsrc)],
+                          end - begin);
+}
+
+/**
+ * \brief Converts data from one to another type
+ * \param tdest destination data type
+ * \param dest destination data pointer (must be already allocated)
+ * \param tsrc source data type
+ * \param src source data pointer
+ * \param n number of elements in \p src (not bytes, just the number of typed
+ * values)
+ *
+ * Large conversions are split over the job system.
+ * \sa SCE_Type_ConvertDup()
+ */
+void SCE_Type_Convert (int tdest, void *dest, int tsrc,
+                       const void *src, size_t n)
+{
+    SCE_STypeConversion c;
+
+    if (n < 2 * SCE_TYPE_PARALLEL_MIN) {
+        SCE_Type_ConvertPart (tdest, dest, tsrc, src, n);
+        return;
+    }
+    c.tdest = tdest;
+    c.tsrc = tsrc;
+    c.dest = dest;
+    c.src = src;
+    SCE_Jobs_ParallelFor (0, n, SCE_TYPE_PARALLEL_MIN, SCE_Type_ConvertRange,
+                          &c);
+}
+
 /**
  * \brief Converts data and allocates memory for them
  * \param tdest destination type
@@ -0,0 +1,613 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEUList.h"
+
+/**
+ * \file SCEUList.c
+ * \copydoc ulist
+ * \brief Unrolled linked lists
+ *
+ * \file SCEUList.h
+ * \copydoc ulist
+ * \brief Unrolled linked lists
+ */
+
+/**
+ * \defgroup ulist Unrolled linked lists
+ * \ingroup utils
+ * \brief Linked lists of small arrays
+ *
+ * An unrolled list stores up to SCE_ULIST_NODE_LENGTH data pointers per
+ * node, traversing it touches a few cache lines per node instead of one
+ * node per element like SCE_SList does, while lists can still be spliced in
+ * constant time.
+ *
+ * Elements are referenced by SCE_SUListIt handles. An element never changes
+ * of slot inside its node, but an insertion into a full node or a splice
+ * splits the node, and a removal merges nodes that are at most half full,
+ * which moves elements to another node. The handle given to an insertion
+ * function is tracked: the list updates it when its element moves, so it
+ * remains valid until the element is removed, as long as it stays at the
+ * same address (see SCE_UList_Untrack()). Other handles, like the ones
+ * given by SCE_UList_GetFirst() or used by the loops, are invalidated when
+ * their element moves. SCE_UList_Remove() never moves the elements that
+ * precede the removed one.
+ */
+
+/** @{ */
+
+static SCE_SUListNode* SCE_UList_NewNode (void)
+{
+    SCE_SUListNode *node = NULL;
+    if (!(node = SCE_malloc (sizeof *node))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    node->next = node->prev = NULL;
+    node->used = 0;
+    node->n = 0;
+    return node;
+}
+
+/* moves the element at position \p pos of \p src at the end of \p dst,
+   \p dst must not be full and the caller updates \p src->n */
+static void SCE_UList_Move (SCE_SUListNode *dst, SCE_SUListNode *src,
+                            unsigned int pos)
+{
+    unsigned int from = src->order[pos];
+    unsigned int slot = __builtin_ctz (~dst->used);
+    SCE_SUListIt *it = src->its[from];
+
+    dst->used |= 1u << slot;
+    dst->order[dst->n] = slot;
+    dst->data[slot] = src->data[from];
+    dst->its[slot] = it;
+    if (it) {
+        it->node = dst;
+        it->slot = slot;
+        it->pos = dst->n;
+    }
+    dst->n++;
+    src->used &= ~(1u << from);
+}
+
+/* links \p node after \p prev, or at the beginning of \p l if \p prev is
+   NULL */
+static void SCE_UList_LinkNode (SCE_SUList *l, SCE_SUListNode *prev,
+                                SCE_SUListNode *node)
+{
+    node->prev = prev;
+    node->next = prev ? prev->next : l->first;
+    if (node->next)
+        node->next->prev = node;
+    else
+        l->last = node;
+    if (prev)
+        prev->next = node;
+    else
+        l->first = node;
+}
+static void SCE_UList_UnlinkNode (SCE_SUList *l, SCE_SUListNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        l->first = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        l->last = node->prev;
+}
+
+/* position of the element \p it in its node */
+static unsigned int SCE_UList_Locate (SCE_SUListIt *it)
+{
+    SCE_SUListNode *node = it->node;
+    unsigned int i;
+
+    if (it->pos < node->n && node->order[it->pos] == it->slot)
+        return it->pos;
+    for (i = 0; i < node->n && node->order[i] != it->slot; i++)
+        ;
+    it->pos = i;
+    return i;
+}
+
+/* moves the elements of \p node from \p pos to a new node linked after it */
+static SCE_SUListNode* SCE_UList_Split (SCE_SUList *l, SCE_SUListNode *node,
+                                        unsigned int pos)
+{
+    SCE_SUListNode *new = NULL;
+    unsigned int i;
+
+    if (!(new = SCE_UList_NewNode ())) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    for (i = pos; i < node->n; i++)
+        SCE_UList_Move (new, node, i);
+    node->n = pos;
+    SCE_UList_LinkNode (l, node, new);
+    return new;
+}
+
+/* moves the elements of \p next at the end of \p node and frees \p next,
+   \p next must follow \p node and both must fit in one node */
+static void SCE_UList_Merge (SCE_SUList *l, SCE_SUListNode *node,
+                             SCE_SUListNode *next)
+{
+    unsigned int i;
+
+    for (i = 0; i < next->n; i++)
+        SCE_UList_Move (node, next, i);
+    SCE_UList_UnlinkNode (l, next);
+    SCE_free (next);
+}
+
+/* inserts \p data at position \p pos of \p node, which is at most
+   \p node->n; \p node can be empty, full nodes are split or the element
+   goes into a neighbour node */
+static int SCE_UList_InsertAt (SCE_SUList *l, SCE_SUListNode *node,
+                               unsigned int pos, void *data,
+                               SCE_SUListIt *it)
+{
+    unsigned int slot;
+
+    if (node->n == SCE_ULIST_NODE_LENGTH) {
+        SCE_SUListNode *other = NULL;
+        if (pos == node->n) {
+            other = node->next;
+            if (!other || other->n == SCE_ULIST_NODE_LENGTH) {
+                if (!(other = SCE_UList_NewNode ()))
+                    goto fail;
+                SCE_UList_LinkNode (l, node, other);
+            }
+            node = other;
+            pos = 0;
+        } else if (pos == 0) {
+            other = node->prev;
+            if (!other || other->n == SCE_ULIST_NODE_LENGTH) {
+                if (!(other = SCE_UList_NewNode ()))
+                    goto fail;
+                SCE_UList_LinkNode (l, node->prev, other);
+            }
+            node = other;
+            pos = node->n;
+        } else if (!SCE_UList_Split (l, node, pos))
+            goto fail;
+    }
+
+    slot = __builtin_ctz (~node->used);
+    node->used |= 1u << slot;
+    memmove (&node->order[pos + 1], &node->order[pos], node->n - pos);
+    node->order[pos] = slot;
+    node->data[slot] = data;
+    node->its[slot] = it;
+    node->n++;
+    l->length++;
+    if (it) {
+        it->node = node;
+        it->slot = slot;
+        it->pos = pos;
+    }
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+
+
+/**
+ * \brief Initializes an unrolled list
+ * \param l the list to initialize
+ */
+void SCE_UList_Init (SCE_SUList *l)
+{
+    l->first = l->last = NULL;
+    l->length = 0;
+    l->f = NULL;
+}
+/**
+ * \brief Clears an unrolled list, calls the free function on each element
+ * \param l the list to clear
+ */
+void SCE_UList_Clear (SCE_SUList *l)
+{
+    SCE_SUListNode *node = l->first, *next = NULL;
+
+    while (node) {
+        unsigned int i;
+        next = node->next;
+        if (l->f) {
+            for (i = 0; i < node->n; i++)
+                l->f (node->data[node->order[i]]);
+        }
+        SCE_free (node);
+        node = next;
+    }
+    l->first = l->last = NULL;
+    l->length = 0;
+}
+/**
+ * \brief Creates a new unrolled list
+ * \param f free function of the elements, can be NULL
+ * \returns a newly allocated list, or NULL on error
+ */
+SCE_SUList* SCE_UList_Create (SCE_FListFreeFunc f)
+{
+    SCE_SUList *l = NULL;
+    if (!(l = SCE_malloc (sizeof *l)))
+        SCEE_LogSrc ();
+    else {
+        SCE_UList_Init (l);
+        l->f = f;
+    }
+    return l;
+}
+/**
+ * \brief Deletes an unrolled list
+ * \param l the list to delete
+ */
+void SCE_UList_Delete (SCE_SUList *l)
+{
+    if (l) {
+        SCE_UList_Clear (l);
+        SCE_free (l);
+    }
+}
+
+/**
+ * \brief Sets the function called on each element by SCE_UList_Clear()
+ * and SCE_UList_Erase()
+ */
+void SCE_UList_SetFreeFunc (SCE_SUList *l, SCE_FListFreeFunc f)
+{
+    l->f = f;
+}
+
+/**
+ * \brief Adds an element at the end of an unrolled list
+ * \param l a list
+ * \param data the element to add
+ * \param it if not NULL, receives the handle of the new element, which is
+ * tracked until the element is removed
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_UList_Append (SCE_SUList *l, void *data, SCE_SUListIt *it)
+{
+    if (!l->last) {
+        SCE_SUListNode *node = NULL;
+        if (!(node = SCE_UList_NewNode ()))
+            goto fail;
+        SCE_UList_LinkNode (l, NULL, node);
+    }
+    if (SCE_UList_InsertAt (l, l->last, l->last->n, data, it) < 0)
+        goto fail;
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+/**
+ * \brief Adds an element at the beginning of an unrolled list
+ * \param l a list
+ * \param data the element to add
+ * \param it if not NULL, receives the handle of the new element, which is
+ * tracked until the element is removed
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_UList_Prepend (SCE_SUList *l, void *data, SCE_SUListIt *it)
+{
+    if (!l->first) {
+        SCE_SUListNode *node = NULL;
+        if (!(node = SCE_UList_NewNode ()))
+            goto fail;
+        SCE_UList_LinkNode (l, NULL, node);
+    }
+    if (SCE_UList_InsertAt (l, l->first, 0, data, it) < 0)
+        goto fail;
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+/**
+ * \brief Inserts an element after another one
+ * \param l a list
+ * \param pos handle of an element of \p l
+ * \param data the element to add
+ * \param it if not NULL, receives the handle of the new element, which is
+ * tracked until the element is removed
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_UList_InsertAfter (SCE_SUList *l, SCE_SUListIt *pos, void *data,
+                           SCE_SUListIt *it)
+{
+    if (SCE_UList_InsertAt (l, pos->node, SCE_UList_Locate (pos) + 1,
+                            data, it) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Inserts an element before another one
+ * \param l a list
+ * \param pos handle of an element of \p l
+ * \param data the element to add
+ * \param it if not NULL, receives the handle of the new element, which is
+ * tracked until the element is removed
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ */
+int SCE_UList_InsertBefore (SCE_SUList *l, SCE_SUListIt *pos, void *data,
+                            SCE_SUListIt *it)
+{
+    if (SCE_UList_InsertAt (l, pos->node, SCE_UList_Locate (pos), data,
+                            it) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Removes an element of an unrolled list
+ * \param l the list of \p it
+ * \param it handle of the element to remove, invalid after this call
+ * \returns the data of the removed element
+ *
+ * When the node of \p it and one of its neighbours are at most half full
+ * they are merged: tracked handles are updated, the elements preceding
+ * \p it never move.
+ * \sa SCE_UList_Erase()
+ */
+void* SCE_UList_Remove (SCE_SUList *l, SCE_SUListIt *it)
+{
+    SCE_SUListNode *node = it->node;
+    unsigned int pos = SCE_UList_Locate (it);
+    void *data = node->data[it->slot];
+
+    node->n--;
+    memmove (&node->order[pos], &node->order[pos + 1], node->n - pos);
+    node->used &= ~(1u << it->slot);
+    l->length--;
+    if (!node->n) {
+        SCE_UList_UnlinkNode (l, node);
+        SCE_free (node);
+    } else if (node->n <= SCE_ULIST_NODE_LENGTH / 2) {
+        /* only the elements after the removed one can move */
+        if (node->next && node->next->n <= SCE_ULIST_NODE_LENGTH / 2)
+            SCE_UList_Merge (l, node, node->next);
+        else if (pos == 0 && node->prev &&
+                 node->prev->n <= SCE_ULIST_NODE_LENGTH / 2)
+            SCE_UList_Merge (l, node->prev, node);
+    }
+    return data;
+}
+/**
+ * \brief Removes an element and calls the free function of the list on it
+ * \sa SCE_UList_Remove(), SCE_UList_SetFreeFunc()
+ */
+void SCE_UList_Erase (SCE_SUList *l, SCE_SUListIt *it)
+{
+    void *data = SCE_UList_Remove (l, it);
+    if (l->f)
+        l->f (data);
+}
+/**
+ * \brief Stops tracking a handle given to an insertion function
+ * \param it a tracked handle
+ *
+ * Must be called before releasing the memory of a tracked handle whose
+ * element stays in its list. \p it remains valid until its element moves.
+ */
+void SCE_UList_Untrack (SCE_SUListIt *it)
+{
+    if (it->node->its[it->slot] == it)
+        it->node->its[it->slot] = NULL;
+}
+
+/**
+ * \brief Moves all the elements of \p l2 at the end of \p l1
+ *
+ * \p l2 is empty after this call, the handles of its elements remain valid.
+ * This is O(1).
+ * \sa SCE_UList_Insert(), SCE_UList_Extract()
+ */
+void SCE_UList_Join (SCE_SUList *l1, SCE_SUList *l2)
+{
+    if (!l2->first)
+        return;
+    if (l1->last) {
+        l1->last->next = l2->first;
+        l2->first->prev = l1->last;
+    } else
+        l1->first = l2->first;
+    l1->last = l2->last;
+    l1->length += l2->length;
+    l2->first = l2->last = NULL;
+    l2->length = 0;
+}
+/**
+ * \brief Moves all the elements of \p l2 after an element of \p l1
+ * \param l1 a list
+ * \param pos handle of an element of \p l1, or NULL to insert at the
+ * beginning of \p l1
+ * \param l2 the list to insert, empty after this call
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The node of \p pos is split if \p pos is not its last element, the
+ * elements after \p pos then move to a new node.
+ * \sa SCE_UList_Join(), SCE_UList_Extract()
+ */
+int SCE_UList_Insert (SCE_SUList *l1, SCE_SUListIt *pos, SCE_SUList *l2)
+{
+    SCE_SUListNode *prev = NULL;
+
+    if (!l2->first)
+        return SCE_OK;
+    if (pos) {
+        unsigned int i = SCE_UList_Locate (pos) + 1;
+        prev = pos->node;
+        if (i < prev->n && !SCE_UList_Split (l1, prev, i)) {
+            SCEE_LogSrc ();
+            return SCE_ERROR;
+        }
+    }
+    l2->last->next = prev ? prev->next : l1->first;
+    if (l2->last->next)
+        l2->last->next->prev = l2->last;
+    else
+        l1->last = l2->last;
+    l2->first->prev = prev;
+    if (prev)
+        prev->next = l2->first;
+    else
+        l1->first = l2->first;
+    l1->length += l2->length;
+    l2->first = l2->last = NULL;
+    l2->length = 0;
+    return SCE_OK;
+}
+/**
+ * \brief Moves the elements of \p l1 from \p pos to the end of \p l2
+ * \param l1 a list
+ * \param pos handle of the first element to move
+ * \param l2 the list receiving the elements
+ * \returns SCE_OK on success, SCE_ERROR on failure
+ *
+ * The node of \p pos is split if \p pos is not its first element, the
+ * moved elements then go to a new node.
+ * \sa SCE_UList_Join(), SCE_UList_Insert()
+ */
+int SCE_UList_Extract (SCE_SUList *l1, SCE_SUListIt *pos, SCE_SUList *l2)
+{
+    SCE_SUListNode *node = pos->node;
+    SCE_SUList tail;
+    unsigned int i = SCE_UList_Locate (pos);
+
+    if (i > 0 && !(node = SCE_UList_Split (l1, node, i))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    SCE_UList_Init (&tail);
+    tail.first = node;
+    tail.last = l1->last;
+    l1->last = node->prev;
+    if (l1->last)
+        l1->last->next = NULL;
+    else
+        l1->first = NULL;
+    node->prev = NULL;
+    for (; node; node = node->next)
+        tail.length += node->n;
+    l1->length -= tail.length;
+    SCE_UList_Join (l2, &tail);
+    return SCE_OK;
+}
+
+/**
+ * \brief Gets the number of elements of an unrolled list
+ */
+size_t SCE_UList_GetLength (const SCE_SUList *l)
+{
+    return l->length;
+}
+/**
+ * \brief Does an unrolled list has elements?
+ */
+int SCE_UList_HasElements (const SCE_SUList *l)
+{
+    return (l->first ? SCE_TRUE : SCE_FALSE);
+}
+/**
+ * \brief Gets the first element of an unrolled list
+ * \param l a list
+ * \param it receives the handle of the element, its \c node is NULL if
+ * \p l is empty
+ * \returns SCE_TRUE if \p l has elements, SCE_FALSE otherwise
+ */
+int SCE_UList_GetFirst (const SCE_SUList *l, SCE_SUListIt *it)
+{
+    it->node = l->first;
+    it->pos = 0;
+    if (!it->node)
+        return SCE_FALSE;
+    it->slot = it->node->order[0];
+    return SCE_TRUE;
+}
+/**
+ * \brief Gets the last element of an unrolled list
+ * \sa SCE_UList_GetFirst()
+ */
+int SCE_UList_GetLast (const SCE_SUList *l, SCE_SUListIt *it)
+{
+    it->node = l->last;
+    it->pos = 0;
+    if (!it->node)
+        return SCE_FALSE;
+    it->pos = it->node->n - 1;
+    it->slot = it->node->order[it->pos];
+    return SCE_TRUE;
+}
+/**
+ * \brief Moves a handle to the next element
+ * \param it a handle
+ * \returns SCE_FALSE if \p it was the last element, then its \c node is set
+ * to NULL, SCE_TRUE otherwise
+ */
+int SCE_UList_GetNext (SCE_SUListIt *it)
+{
+    unsigned int pos = SCE_UList_Locate (it) + 1;
+    if (pos == it->node->n) {
+        it->node = it->node->next;
+        pos = 0;
+        if (!it->node)
+            return SCE_FALSE;
+    }
+    it->pos = pos;
+    it->slot = it->node->order[pos];
+    return SCE_TRUE;
+}
+/**
+ * \brief Moves a handle to the previous element
+ * \sa SCE_UList_GetNext()
+ */
+int SCE_UList_GetPrev (SCE_SUListIt *it)
+{
+    unsigned int pos = SCE_UList_Locate (it);
+    if (pos == 0) {
+        it->node = it->node->prev;
+        if (!it->node)
+            return SCE_FALSE;
+        pos = it->node->n;
+    }
+    it->pos = pos - 1;
+    it->slot = it->node->order[it->pos];
+    return SCE_TRUE;
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 13/02/2009
-   updated: 10/04/2010 */
+   updated: 18/10/2026 */
 
 #include <stdio.h>
 #include <pthread.h>
@@ -43,8 +43,26 @@ static unsigned int init_n = 0;
  * Initialization is thread-safe. Initialization is stacked, so it can be done
  * more than once, but each initialization call must have a corresponding
  * uninitialization call (SCE_Quit_Utils ()).
+ * \sa SCE_Init_Utils2()
  */
 int SCE_Init_Utils (FILE *outlog)
+{
+    return SCE_Init_Utils2 (outlog, NULL);
+}
+/**
+ * \brief Initializes the sub-module 'utils' of the SCEngine with a custom
+ * allocator
+ * \param outlog stream where write the error messages
+ * \param allocator allocator every module of the library will use, NULL for
+ * the C library
+ * \return SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Same as SCE_Init_Utils(), \p allocator is installed with
+ * SCE_Mem_SetAllocator() by the first initialization only, before anything
+ * is allocated. Later initializations ignore it.
+ * \sa SCE_Init_Utils(), SCE_Mem_SetAllocator()
+ */
+int SCE_Init_Utils2 (FILE *outlog, const SCE_SMemAllocator *allocator)
 {
     int ret = SCE_OK;
     if (pthread_mutex_lock (&init_mutex) != 0) {
@@ -57,9 +75,18 @@ int SCE_Init_Utils (FILE *outlog)
     if (init_n == 1) {
         SCE_Init_Error (outlog);
         ret = SCE_ERROR;
-        if (SCE_Init_Mem () < 0) {
+        if (allocator && SCE_Mem_SetAllocator (allocator) < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't install the allocator");
+        } else if (SCE_Init_Mem () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize memory manager");
+        } else if (SCE_Init_Arena () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize arenas manager");
+        } else if (SCE_Init_Jobs () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize jobs manager");
         } else if (SCE_Init_Matrix () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize matrices manager");
@@ -97,6 +124,8 @@ void SCE_Quit_Utils (void)
             SCE_Quit_Resource ();
             SCE_Quit_Media ();
             SCE_Quit_FastList ();
+            SCE_Quit_Jobs ();
+            SCE_Quit_Arena ();
             /*SCE_Quit_Matrix ();*/
             /*SCE_Quit_Error ();*/
             SCE_Quit_Mem ();
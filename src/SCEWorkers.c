@@ -0,0 +1,99 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2012  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 18/10/2026 */
+
+#include <stdlib.h>
+
+#include "SCE/utils/SCEJobs.h"
+#include "SCE/utils/SCEWorkers.h"
+
+/**
+ * \file SCEWorkers.c
+ * \copydoc workers
+ * \brief Shared worker threads
+ *
+ * \file SCEWorkers.h
+ * \copydoc workers
+ * \brief Shared worker threads
+ */
+
+/**
+ * \defgroup workers Shared worker threads
+ * \ingroup utils
+ * \brief Batches of tasks run by the job system
+ *
+ * A batch is a number of independent tasks: the workers of the job system
+ * (see \ref jobs) and the calling thread take them and SCE_Workers_Run()
+ * returns once all of them are done. Batches can run at the same time and
+ * a batch started from inside a task is spread over the workers too.
+ */
+
+/** @{ */
+
+/* number of parts of a batch per thread, more parts balance the load
+   better but cost more jobs */
+#define SCE_WORKERS_PARTS_PER_THREAD 8
+
+typedef struct sce_sworkersbatch SCE_SWorkersBatch;
+struct sce_sworkersbatch {
+    SCE_FWorkerFunc func;
+    void *data;
+};
+
+static void SCE_Workers_Range (size_t begin, size_t end, void *data)
+{
+    SCE_SWorkersBatch *b = data;
+    for (; begin < end; begin++)
+        b->func (begin, b->data);
+}
+
+/**
+ * \brief Gets the number of threads running the tasks of a batch
+ * \returns the number of worker threads plus one for the calling thread
+ * \sa SCE_Jobs_GetCount()
+ */
+unsigned int SCE_Workers_GetCount (void)
+{
+    return SCE_Jobs_GetCount ();
+}
+
+/**
+ * \brief Runs a batch of tasks on the worker threads
+ * \param n number of tasks
+ * \param func function running one task
+ * \param data user data given to \p func
+ *
+ * Calls \p func for each task index from 0 to \p n - 1, in any order and
+ * from any thread including the calling one. Returns when all the tasks
+ * are done.
+ * \sa SCE_Jobs_ParallelFor()
+ */
+void SCE_Workers_Run (unsigned int n, SCE_FWorkerFunc func, void *data)
+{
+    SCE_SWorkersBatch b;
+    unsigned int grain = n / (SCE_Jobs_GetCount () *
+                              SCE_WORKERS_PARTS_PER_THREAD);
+
+    b.func = func;
+    b.data = data;
+    SCE_Jobs_ParallelFor (0, n, grain, SCE_Workers_Range, &b);
+}
+
+/** @} */